@@ -0,0 +1,153 @@
+#!/bin/sh
+#
+# Compile time and code size of a translation unit that dumps the same
+# structure with all four backends.
+#
+# Usage: bench/backends.sh [runs] [include directory to compare]
+#
+# The user dumper is instantiated once per backend. With an include
+# directory that provides `dump/traversal.hpp` it is additionally built
+# once on top of `dump::traversal` and used with the four formats.
+#
+# The code size is the text segment of the object file. With
+# DUMP_SEPARATE_COMPILATION ("separate") it only contains the templates
+# instantiated by the translation unit, the rest is in `dump_core`.
+#
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+RUNS=${1:-5}
+OTHER=$2
+CXX=${CXX:-c++}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Self-contained so that it also compiles against older checkouts
+cat > "$WORK/backends.cpp" <<'CPP'
+#include "dump/console.hpp"
+#include "dump/forest.hpp"
+#include "dump/plaintext.hpp"
+#include "dump/tikz.hpp"
+#if __has_include("dump/std_support.hpp")
+#  include "dump/std_support.hpp"
+#endif
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+struct tire {
+    std::string manufacturer;
+    unsigned width;
+    float size;
+};
+
+struct engine {
+    int power;
+    std::vector<double> torque;
+};
+
+struct car {
+    std::string model;
+    engine main_engine;
+    std::vector<tire> tires;
+    std::map<int, std::vector<tire>> spares;
+};
+
+template <template <typename> class Base>
+struct dumper : public Base<dumper<Base>> {
+    typedef dumper<Base> Self;
+    using Base<Self>::Base;
+    using Base<Self>::operator();
+
+    void operator()(tire const& obj) {
+        this->cNode(obj, "Tire");
+        this->cAttr(obj, "manufacturer", obj.manufacturer, false, true);
+        this->cAttr(obj, "width", obj.width, false, true);
+        this->cAttr(obj, "size", obj.size, true, true);
+    }
+
+    void operator()(engine const& obj) {
+        this->cNode(obj, "Engine");
+        this->cAttr(obj, "power", obj.power, false, true);
+        this->cAttr(obj, "torque", obj.torque, true);
+    }
+
+    void operator()(std::pair<int const, std::vector<tire>> const& obj) {
+        this->cNode(obj, "Spares");
+        this->cAttr(obj, "axle", obj.first, false, true);
+        this->cAttr(obj, "tires", obj.second, true);
+    }
+
+    void operator()(car const& obj) {
+        this->cNode(obj, "Car");
+        this->cAttr(obj, "model", obj.model, false, true);
+        this->cAttr(obj, "engine", obj.main_engine, false);
+        this->cAttr(obj, "tires", obj.tires, false);
+        this->cAttr(obj, "spares", obj.spares, true);
+    }
+};
+
+int main() {
+    tire t{"Tire Brand", 215, 16};
+    car c{"Model 2000", {100, {1.0, 2.0}}, {t, t, t, t}, {{1, {t}}}};
+#if defined(SHARED)
+    {
+        dump::plaintext_format format{std::cout};
+        dumper<dump::traversal>{format}(c);
+    }
+    {
+        dump::console_format format{std::cout};
+        dumper<dump::traversal>{format}(c);
+    }
+    {
+        dump::tikz_format format{std::cout};
+        dumper<dump::traversal>{format}(c);
+    }
+    {
+        dump::forest_format format{std::cout};
+        dumper<dump::traversal>{format}(c);
+    }
+#else
+    dumper<dump::plaintext_dumper>{std::cout}(c);
+    dumper<dump::console_dumper>{std::cout}(c);
+    dumper<dump::tikz_dumper>{std::cout}(c);
+    dumper<dump::forest_dumper>{std::cout}(c);
+#endif
+}
+CPP
+
+# Average compile time in milliseconds and code size of the object file
+measure() {
+    total=0
+    i=0
+    while [ $i -lt "$RUNS" ]; do
+        start=$(date +%s%N)
+        $CXX -std=c++14 -O2 -c "$@" "$WORK/backends.cpp" \
+             -o "$WORK/backends.o"
+        end=$(date +%s%N)
+        total=$((total + (end - start) / 1000000))
+        i=$((i + 1))
+    done
+    printf '%6s ms %8s bytes\n' \
+           $((total / RUNS)) "$(size "$WORK/backends.o" | awk 'NR==2 {print $1}')"
+}
+
+# Prints one line per include directory and mode
+run() {
+    name=$1
+    shift
+    printf '%-40s %s\n' "$name" "$(measure "$@")"
+    printf '%-40s %s\n' "$name, separate" \
+           "$(measure -DDUMP_SEPARATE_COMPILATION "$@")"
+}
+
+run "per backend" -I"$ROOT/include"
+run "shared traversal" -DSHARED -I"$ROOT/include"
+if [ -n "$OTHER" ]; then
+    run "$OTHER" -I"$OTHER"
+    if [ -f "$OTHER/dump/traversal.hpp" ]; then
+        run "$OTHER shared traversal" -DSHARED -I"$OTHER"
+    fi
+fi
@@ -0,0 +1,90 @@
+#!/bin/sh
+#
+# Compile time of a translation unit that dumps the demo car as plain text.
+#
+# Usage: bench/compile_time.sh [runs] [include directory to compare]
+#
+# The second argument can point to the `include` directory of another
+# checkout to compare against, e.g. one extracted with
+#   git archive <rev> include | tar -x -C /tmp/<rev>
+#
+set -e
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+RUNS=${1:-5}
+OTHER=$2
+CXX=${CXX:-c++}
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Self-contained so that it also compiles against older checkouts
+cat > "$WORK/plaintext.cpp" <<'CPP'
+#include "dump/plaintext.hpp"
+#if __has_include("dump/std_support.hpp")
+#  include "dump/std_support.hpp"
+#endif
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct tire {
+    std::string manufacturer;
+    unsigned width;
+    float size;
+};
+
+struct car {
+    std::string model;
+    std::vector<tire> tires;
+};
+
+template <template <typename> class Base>
+struct dumper : public Base<dumper<Base>> {
+    typedef dumper<Base> Self;
+    using Base<Self>::Base;
+    using Base<Self>::operator();
+
+    void operator()(tire const& obj) {
+        this->cNode(obj, "Tire");
+        this->cAttr(obj, "manufacturer", obj.manufacturer, false, true);
+        this->cAttr(obj, "width", obj.width, false, true);
+        this->cAttr(obj, "size", obj.size, true, true);
+    }
+
+    void operator()(car const& obj) {
+        this->cNode(obj, "Car");
+        this->cAttr(obj, "model", obj.model, false, true);
+        this->cAttr(obj, "tires", obj.tires, true);
+    }
+};
+
+int main() {
+    tire t{"Tire Brand", 215, 16};
+    car c{"Model 2000", {t, t, t, t}};
+    dumper<dump::plaintext_dumper>{std::cout}(c);
+}
+CPP
+
+# Average wall time in milliseconds of compiling with the given flags
+measure() {
+    total=0
+    i=0
+    while [ $i -lt "$RUNS" ]; do
+        start=$(date +%s%N)
+        $CXX -std=c++14 -O2 -c "$@" "$WORK/plaintext.cpp" \
+             -o "$WORK/plaintext.o"
+        end=$(date +%s%N)
+        total=$((total + (end - start) / 1000000))
+        i=$((i + 1))
+    done
+    echo $((total / RUNS))
+}
+
+printf '%-28s %6s ms\n' "header-only" \
+       "$(measure -I"$ROOT/include")"
+printf '%-28s %6s ms\n' "DUMP_SEPARATE_COMPILATION" \
+       "$(measure -DDUMP_SEPARATE_COMPILATION -I"$ROOT/include")"
+if [ -n "$OTHER" ]; then
+    printf '%-28s %6s ms\n' "$OTHER" "$(measure -I"$OTHER")"
+fi
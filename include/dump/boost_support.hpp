@@ -0,0 +1,37 @@
+#ifndef DUMP_BOOST_SUPPORT_HPP
+#define DUMP_BOOST_SUPPORT_HPP
+
+#include "dump/traits.hpp"
+
+#include <boost/optional.hpp>
+#include <boost/variant.hpp>
+
+namespace dump {
+
+    template <typename... _Args>
+    struct traversal_traits<boost::variant<_Args...>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper,
+                          boost::variant<_Args...> const& op) {
+            variant_visitor<Dumper, boost::variant<_Args...>> visitor{
+                dumper, op};
+            boost::apply_visitor(visitor, op);
+        }
+    };
+
+    template <typename T>
+    struct traversal_traits<boost::optional<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, boost::optional<T> const& op) {
+            if(op) {
+                dumper.cAlias(op, op.get());
+                dumper.cWrapped(op.get());
+            } else {
+                dumper.cUndefined();
+            }
+        }
+    };
+
+}
+
+#endif //DUMP_BOOST_SUPPORT_HPP
@@ -0,0 +1,55 @@
+#ifndef DUMP_COMPRESSED_HPP
+#define DUMP_COMPRESSED_HPP
+
+#include "dump/compression.hpp"
+#include "dump/config.hpp"
+
+#include <memory>
+#include <ostream>
+
+namespace dump {
+
+    /**
+     * Output stream which compresses everything written to it into `sink`
+     * on a separate thread, so the traversal only copies into a buffer:
+     *
+     *     std::ofstream file{"state.txt.gz", std::ios::binary};
+     *     dump::compressed_ostream out{file, dump::gzip};
+     *     my_dumper<dump::plaintext_dumper>{out}(obj);
+     *
+     * At most a few buffers wait for the compressor, a faster dump blocks
+     * until they are written. The stream is closed on destruction, `close`
+     * reports the errors of the compressor or the sink instead.
+     */
+    struct compressed_ostream : std::ostream {
+        /**
+         * `level` is the codec's default if negative.
+         */
+        DUMP_DECL explicit compressed_ostream(std::ostream& sink,
+                                              compression codec = gzip,
+                                              int level = -1);
+
+        DUMP_DECL ~compressed_ostream();
+
+        compressed_ostream(compressed_ostream const&) = delete;
+        compressed_ostream& operator=(compressed_ostream const&) = delete;
+
+        /**
+         * Compress the rest, flush the sink and wait for the thread.
+         * Rethrows the first error of the thread.
+         */
+        DUMP_DECL void close();
+
+    private:
+        struct buffer;
+
+        std::unique_ptr<buffer> pending;
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/compressed.ipp"
+#endif
+
+#endif //DUMP_COMPRESSED_HPP
@@ -0,0 +1,26 @@
+#ifndef DUMP_COMPRESSION_HPP
+#define DUMP_COMPRESSION_HPP
+
+namespace dump {
+
+    /**
+     * Codecs of the `compressed_ostream`, declared on their own so that
+     * options can name them without depending on the compressors.
+     */
+    enum compression {
+        uncompressed,
+
+        /**
+         * gzip format of zlib's deflate, readable by `gunzip`.
+         */
+        gzip,
+
+        /**
+         * Zstandard, faster at similar ratios, readable by `unzstd`.
+         */
+        zstd
+    };
+
+}
+
+#endif //DUMP_COMPRESSION_HPP
@@ -0,0 +1,17 @@
+#ifndef DUMP_CONFIG_HPP
+#define DUMP_CONFIG_HPP
+
+/*
+ * The library is header-only by default. Its non-template parts can be
+ * compiled once into the `dump_core` library instead, in which case
+ * `DUMP_SEPARATE_COMPILATION` has to be defined for every translation unit
+ * (the CMake target does this for its users).
+ */
+#if defined(DUMP_SEPARATE_COMPILATION)
+#  define DUMP_DECL
+#else
+#  define DUMP_HEADER_ONLY 1
+#  define DUMP_DECL inline
+#endif
+
+#endif //DUMP_CONFIG_HPP
@@ -0,0 +1,99 @@
+#ifndef DUMP_CONTAINER_SUPPORT_HPP
+#define DUMP_CONTAINER_SUPPORT_HPP
+
+#include "dump/std_support.hpp"
+#include "dump/traits.hpp"
+
+#include <boost/circular_buffer_fwd.hpp>
+#include <boost/container/container_fwd.hpp>
+
+#include <cstddef>
+
+namespace dump {
+
+    /*
+     * Boost.Container, the items are listed in place. The template
+     * parameters are matched as packs as the options were added to the
+     * containers one Boost release after the other. Items of the maps are
+     * `std::pair`s.
+     */
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::vector<_Args...>>
+        : list_traversal_traits<boost::container::vector<_Args...>> {};
+
+    template <typename T, std::size_t N, typename... _Args>
+    struct traversal_traits<boost::container::small_vector<T, N, _Args...>>
+        : list_traversal_traits<
+              boost::container::small_vector<T, N, _Args...>> {};
+
+    template <typename T, std::size_t N, typename... _Args>
+    struct traversal_traits<boost::container::static_vector<T, N, _Args...>>
+        : list_traversal_traits<
+              boost::container::static_vector<T, N, _Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::stable_vector<_Args...>>
+        : list_traversal_traits<boost::container::stable_vector<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::deque<_Args...>>
+        : list_traversal_traits<boost::container::deque<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::list<_Args...>>
+        : list_traversal_traits<boost::container::list<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::slist<_Args...>>
+        : list_traversal_traits<boost::container::slist<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::set<_Args...>>
+        : list_traversal_traits<boost::container::set<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::multiset<_Args...>>
+        : list_traversal_traits<boost::container::multiset<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::map<_Args...>>
+        : list_traversal_traits<boost::container::map<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::multimap<_Args...>>
+        : list_traversal_traits<boost::container::multimap<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::flat_set<_Args...>>
+        : list_traversal_traits<boost::container::flat_set<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::flat_multiset<_Args...>>
+        : list_traversal_traits<boost::container::flat_multiset<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::flat_map<_Args...>>
+        : list_traversal_traits<boost::container::flat_map<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::container::flat_multimap<_Args...>>
+        : list_traversal_traits<boost::container::flat_multimap<_Args...>> {};
+
+    /*
+     * Boost.CircularBuffer, from the oldest to the newest item. Wrap it
+     * with `latest` to list only the newest ones.
+     */
+
+    template <typename... _Args>
+    struct traversal_traits<boost::circular_buffer<_Args...>>
+        : list_traversal_traits<boost::circular_buffer<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::circular_buffer_space_optimized<_Args...>>
+        : list_traversal_traits<
+              boost::circular_buffer_space_optimized<_Args...>> {};
+
+}
+
+#endif //DUMP_CONTAINER_SUPPORT_HPP
@@ -0,0 +1,228 @@
+#ifndef DUMP_EXPLORER_HPP
+#define DUMP_EXPLORER_HPP
+
+#include "dump/config.hpp"
+#include "dump/console.hpp"
+#include "dump/path_query.hpp"
+#include "dump/traversal.hpp"
+
+#include <cstddef>
+#include <istream>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    struct explorer_options {
+        /**
+         * Items of a list shown at once
+         */
+        std::size_t page = 20;
+
+        /**
+         * Rows of the terminal, including the status line
+         */
+        std::size_t height = 24;
+    };
+
+    /**
+     * Formatting policy of the `explorer`. Writes like the
+     * `console_format` and filters its own dump, so only the attributes
+     * of expanded nodes and the inlined attributes of their children are
+     * visited.
+     *
+     * Attributes are identified by their path of positions from the root.
+     * Items are counted from the start of their list, also when the
+     * previous ones are on another page.
+     */
+    struct explorer_format : console_format, attribute_filter {
+        typedef std::vector<std::size_t> path;
+
+        /**
+         * Line of a node, i.e. the text of a non-inlined attribute up to
+         * the next one.
+         */
+        struct entry {
+            path id;
+
+            /**
+             * Offset of the text in the output
+             */
+            std::size_t offset;
+
+            /**
+             * Whether attributes or items are left out
+             */
+            bool hidden;
+
+            bool expanded;
+
+            /**
+             * Items `[first, last)` of `total` shown, if paged
+             */
+            std::size_t first;
+            std::size_t last;
+            std::size_t total;
+        };
+
+        std::size_t page;
+
+        /**
+         * Nodes which show their attributes
+         */
+        std::set<path> expanded;
+
+        /**
+         * First item shown of the lists of a node
+         */
+        std::map<path, std::size_t> windows;
+
+        /**
+         * Nodes of the last dump, the root first
+         */
+        std::vector<entry> entries;
+
+        DUMP_DECL explorer_format(std::ostream& out, std::size_t page);
+
+        DUMP_DECL void start() override;
+
+        using console_format::leave;
+
+        DUMP_DECL void enter(attribute const& attr) override;
+
+        DUMP_DECL bool enter(string_view, bool, bool inlined,
+                             bool&) override;
+        DUMP_DECL void leave() override;
+        DUMP_DECL void select_items(std::size_t& first,
+                                    std::size_t& last) override;
+
+    private:
+        struct level {
+            std::size_t children;
+            std::size_t entry;
+            bool open;
+        };
+
+        std::vector<level> levels;
+        path current;
+    };
+
+    /**
+     * Interactive view of a data structure in a terminal. Only the root
+     * and its first level are shown at first. Every key press dumps the
+     * structure again, visiting just the expanded nodes and the page of
+     * their lists on screen, so browsing huge or changing structures
+     * costs time proportional to what is visible:
+     *
+     *     dump::raw_terminal raw;
+     *     dump::explore<my_dumper<dump::console_dumper>>(obj, std::cin,
+     *                                                    std::cout);
+     *
+     * Keys: `j`/`k` or the arrow keys move, `l`, the right arrow or enter
+     * expand, `h` or the left arrow collapse or go to the parent, `]` and
+     * `[` show the next and previous page of a list, `q` quits.
+     */
+    struct explorer {
+        explorer_options options;
+
+        /**
+         * Output of the last dump
+         */
+        std::ostringstream text;
+
+        explorer_format format;
+
+        /**
+         * Selected entry
+         */
+        std::size_t cursor;
+
+        /**
+         * First row on screen
+         */
+        std::size_t top;
+
+        DUMP_DECL explicit explorer(
+            explorer_options options = explorer_options());
+
+        explorer(explorer const&) = delete;
+        explorer& operator=(explorer const&) = delete;
+
+        /**
+         * Dump the visible part of `obj` with a child `Dumper` of the
+         * explorer's policy.
+         */
+        template <typename Dumper, typename T>
+        void render(T const& obj) {
+            text.str(std::string());
+            format.start();
+            Dumper{static_cast<format_policy&>(format)}(obj);
+            format.finish();
+            rendered();
+        }
+
+        /**
+         * Clear the terminal and draw the rows around the cursor and a
+         * status line.
+         */
+        DUMP_DECL void draw(std::ostream& out);
+
+        /**
+         * Read and apply one command. Returns false on `q` and at the end
+         * of `in`.
+         */
+        DUMP_DECL bool command(std::istream& in);
+
+    private:
+        /**
+         * Find the selected entry again after a dump.
+         */
+        DUMP_DECL void rendered();
+
+        explorer_format::path selected;
+    };
+
+    /**
+     * Explore `obj` until `q`, reading the keys from `in`. `in` may be a
+     * scripted stream; for a terminal see `raw_terminal`.
+     */
+    template <typename Dumper, typename T>
+    void explore(T const& obj, std::istream& in, std::ostream& out,
+                 explorer_options options = explorer_options()) {
+        explorer view(options);
+        do {
+            view.render<Dumper>(obj);
+            view.draw(out);
+        } while(view.command(in));
+    }
+
+    /**
+     * Switches the standard input of a POSIX terminal to single key
+     * presses without echo while it exists. Does nothing on other
+     * platforms or if the input is not a terminal.
+     */
+    struct raw_terminal {
+        DUMP_DECL raw_terminal();
+        DUMP_DECL ~raw_terminal();
+
+        raw_terminal(raw_terminal const&) = delete;
+        raw_terminal& operator=(raw_terminal const&) = delete;
+
+    private:
+        struct settings;
+
+        std::unique_ptr<settings> saved;
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/explorer.ipp"
+#endif
+
+#endif //DUMP_EXPLORER_HPP
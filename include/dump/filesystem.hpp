@@ -1,17 +1,20 @@
 #ifndef DUMP_FILESYSTEM_HPP
 #define DUMP_FILESYSTEM_HPP
 
+#include "dump/compression.hpp"
+#include "dump/config.hpp"
 #include "dump/console.hpp"
 #include "dump/forest.hpp"
 #include "dump/latex_support.hpp"
 #include "dump/plaintext.hpp"
 #include "dump/tikz.hpp"
 
-#include <boost/filesystem.hpp>
-#include <boost/filesystem/fstream.hpp>
-
+#include <cstddef>
+#include <future>
 #include <iostream>
-#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
 
 namespace dump { namespace dispatch {
     struct full;
@@ -19,6 +22,91 @@ namespace dump { namespace dispatch {
 
 namespace dump {
 
+    /**
+     * Formats written by `fs`, combined with `|`.
+     */
+    enum fs_format : unsigned int {
+        fs_console = 1,
+        fs_plaintext = 2,
+        fs_tikz = 4,
+        fs_forest = 8,
+        fs_all = 15
+    };
+
+    struct fs_options {
+        unsigned int formats = fs_all;
+
+        /**
+         * Directory of the artifacts, the temporary directory if empty.
+         */
+        std::string directory;
+
+        /**
+         * Render the formats on one thread each. The dumper must not
+         * modify shared state.
+         */
+        bool parallel = false;
+
+        /**
+         * Compress the files, which get a `.gz` or `.zst` suffix.
+         */
+        compression codec = uncompressed;
+    };
+
+    /**
+     * Path of a dump artifact in the temporary directory.
+     */
+    DUMP_DECL std::string fs_path(std::string const& project,
+                                  std::string const& artifact,
+                                  std::string const& type,
+                                  std::string const& extension);
+
+    /**
+     * Path of a dump artifact in `directory`, the temporary directory if
+     * empty.
+     */
+    DUMP_DECL std::string fs_path(std::string const& directory,
+                                  std::string const& project,
+                                  std::string const& artifact,
+                                  std::string const& type,
+                                  std::string const& extension);
+
+    /**
+     * Replace the file at `path` with `content` unless it already has
+     * this content, so that its modification time stays the same. The
+     * content is written to a temporary file which is renamed, readers
+     * never see a partial file. Returns whether the file was written.
+     */
+    DUMP_DECL bool fs_write(std::string const& path,
+                            std::string const& content);
+
+    /**
+     * Stream into a temporary file next to `path`, compressed with
+     * `codec`, which `commit` moves to `path` unless the file already has
+     * this content (see `fs_write`). Without a commit the temporary file
+     * is removed on destruction, so errors leave nothing behind.
+     */
+    struct fs_output {
+        DUMP_DECL explicit fs_output(std::string const& path,
+                                     compression codec = uncompressed);
+        DUMP_DECL ~fs_output();
+
+        fs_output(fs_output const&) = delete;
+        fs_output& operator=(fs_output const&) = delete;
+
+        DUMP_DECL std::ostream& stream();
+
+        /**
+         * Finish the file. Returns whether `path` was written.
+         */
+        DUMP_DECL bool commit();
+
+    private:
+        struct state;
+
+        std::unique_ptr<state> pending;
+    };
+
     template <template <template <typename> class, typename> class Dumper,
               typename D = ::dump::dispatch::full,
               bool stdcerr = false,
@@ -27,6 +115,7 @@ namespace dump {
             std::string const& artifact,
             std::string const& type,
             T const& obj,
+            fs_options const& options,
             bool inlined = false) {
 
         // TODO: Turn into `static_if` when available
@@ -36,31 +125,73 @@ namespace dump {
             std::cerr << std::endl << std::endl;
         }
 
-        auto consolef = boost::filesystem::temp_directory_path() / (project + "_" + artifact + "_" + type + ".ansi");
-        boost::filesystem::ofstream consolefs{consolef};
-        Dumper<::dump::console_dumper, D>{consolefs}(obj);
-        consolefs << std::endl;
-
-        auto plainf = boost::filesystem::temp_directory_path() / (project + "_" + artifact + "_" + type + ".txt");
-        boost::filesystem::ofstream plainfs{plainf};
-        Dumper<::dump::plaintext_dumper, D>{plainfs}(obj);
-        plainfs << std::endl;
-
-        auto tikzf = boost::filesystem::temp_directory_path() / (project + "_" + artifact + "_" + type + ".tikz.tex");
-        boost::filesystem::ofstream tikzfs{tikzf};
-        tikzfs << ::dump::latex_support{}.get_header();
-        Dumper<::dump::tikz_dumper, D>{tikzfs, inlined}(obj);
-        tikzfs << ::dump::latex_support{}.get_footer();
-        tikzfs << std::endl;
-
-        auto forestf = boost::filesystem::temp_directory_path() / (project + "_" + artifact + "_" + type + ".forest.tex");
-        boost::filesystem::ofstream forestfs{forestf};
-        forestfs << ::dump::latex_support{}.get_header();
-        Dumper<::dump::forest_dumper, D>{forestfs}(obj);
-        forestfs << ::dump::latex_support{}.get_footer();
-        forestfs << std::endl;
+        static constexpr fs_format formats[] = {
+            fs_console, fs_plaintext, fs_tikz, fs_forest
+        };
+        static constexpr char const* extensions[] = {
+            ".ansi", ".txt", ".tikz.tex", ".forest.tex"
+        };
+        char const* const suffix = options.codec == gzip ? ".gz"
+            : options.codec == zstd ? ".zst" : "";
+        auto const render = [&](std::size_t i) {
+            fs_output file(fs_path(options.directory, project, artifact,
+                                   type, extensions[i] + std::string(suffix)),
+                           options.codec);
+            std::ostream& out = file.stream();
+            switch(formats[i]) {
+            case fs_console:
+                Dumper<::dump::console_dumper, D>{out}(obj);
+                break;
+            case fs_plaintext:
+                Dumper<::dump::plaintext_dumper, D>{out}(obj);
+                break;
+            case fs_tikz:
+                out << ::dump::latex_support{}.get_header();
+                Dumper<::dump::tikz_dumper, D>{out, inlined}(obj);
+                out << ::dump::latex_support{}.get_footer();
+                break;
+            default:
+                out << ::dump::latex_support{}.get_header(false);
+                Dumper<::dump::forest_dumper, D>{out}(obj);
+                out << ::dump::latex_support{}.get_footer();
+                break;
+            }
+            out << std::endl;
+            return file.commit();
+        };
+
+        std::future<bool> rendered[4];
+        std::launch const policy = options.parallel ? std::launch::async
+                                                    : std::launch::deferred;
+        for(std::size_t i = 0; i < 4; ++i) {
+            if(options.formats & formats[i]) {
+                rendered[i] = std::async(policy, render, i);
+            }
+        }
+        for(std::size_t i = 0; i < 4; ++i) {
+            if(rendered[i].valid()) {
+                rendered[i].get();
+            }
+        }
+    }
+
+    template <template <template <typename> class, typename> class Dumper,
+              typename D = ::dump::dispatch::full,
+              bool stdcerr = false,
+              typename T>
+    void fs(std::string const& project,
+            std::string const& artifact,
+            std::string const& type,
+            T const& obj,
+            bool inlined = false) {
+        fs<Dumper, D, stdcerr>(project, artifact, type, obj, fs_options(),
+                               inlined);
     }
 
 }
 
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/filesystem.ipp"
+#endif
+
 #endif //DUMP_FILESYSTEM_HPP
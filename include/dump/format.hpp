@@ -0,0 +1,134 @@
+#ifndef DUMP_FORMAT_HPP
+#define DUMP_FORMAT_HPP
+
+#include "dump/config.hpp"
+
+#include <boost/utility/string_view.hpp>
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+
+namespace dump {
+
+    using string_view = boost::string_view;
+
+    /**
+     * Stack buffer scalar values are formatted into.
+     *
+     * Large enough for `%f` of `DBL_MAX` which is the longest output
+     * `std::to_string` produces for the supported scalar types.
+     */
+    struct number_buffer {
+        char data[328];
+    };
+
+    /*
+     * Format scalars the same way `std::to_string` does, but without
+     * allocating a `std::string` for each value.
+     */
+    DUMP_DECL string_view format(number_buffer& buffer, int value);
+    DUMP_DECL string_view format(number_buffer& buffer, unsigned int value);
+    DUMP_DECL string_view format(number_buffer& buffer, long value);
+    DUMP_DECL string_view format(number_buffer& buffer, unsigned long value);
+    DUMP_DECL string_view format(number_buffer& buffer, double value);
+
+    /**
+     * Human readable name of a type.
+     */
+    DUMP_DECL std::string pretty_name(std::type_info const& type);
+
+    /**
+     * Write `count` spaces.
+     */
+    DUMP_DECL void write_spaces(std::ostream& out, std::size_t count);
+
+    /**
+     * Write `text` and call `separator` in place of every line break.
+     *
+     * This is the streaming counterpart of
+     * `boost::replace_all_copy(text, "\n", replacement)` which does not
+     * need to build the replacement nor the result.
+     */
+    template <typename Separator>
+    void write_lines(std::ostream& out, string_view text,
+                     Separator&& separator) {
+        std::size_t start = 0;
+        for(;;) {
+            std::size_t end = text.find('\n', start);
+            if(end == string_view::npos) {
+                out.write(text.data() + start, text.size() - start);
+                return;
+            }
+            out.write(text.data() + start, end - start);
+            separator(out);
+            start = end + 1;
+        }
+    }
+
+    /**
+     * Write the lowercase hex digits of `size` bytes to `out`, which has to
+     * hold `2 * size` characters.
+     */
+    DUMP_DECL void hex_encode(char* out, unsigned char const* data,
+                              std::size_t size);
+
+    /**
+     * Maximal length of a line written by `hexdump_line`.
+     */
+    constexpr std::size_t hexdump_width = 78;
+
+    /**
+     * Format up to 16 bytes starting at `offset` like `hexdump -C`
+     * (offset, hex bytes and ASCII column) and return the line length.
+     */
+    DUMP_DECL std::size_t hexdump_line(char* line, std::size_t offset,
+                                       unsigned char const* data,
+                                       std::size_t size);
+
+    /**
+     * Write `size` bytes as hexdump and call `separator` between lines.
+     */
+    template <typename Separator>
+    void write_hexdump(std::ostream& out, unsigned char const* data,
+                       std::size_t size, Separator&& separator) {
+        char line[hexdump_width];
+        for(std::size_t offset = 0; offset < size; offset += 16) {
+            if(offset > 0) {
+                separator(out);
+            }
+            std::size_t const n = size - offset < 16 ? size - offset : 16;
+            out.write(line, hexdump_line(line, offset, data + offset, n));
+        }
+    }
+
+    /**
+     * Shorten `text` to at most `max_chars` bytes and `max_lines` lines,
+     * no limit if 0, by replacing its middle with `…(N bytes elided)`.
+     * Only the kept head and tail are scanned. Returns `text` itself if it
+     * is within the limits, otherwise the shortened text in `buffer`.
+     */
+    DUMP_DECL string_view truncate(std::string& buffer, string_view text,
+                                   std::size_t max_chars,
+                                   std::size_t max_lines);
+
+    /**
+     * Characters in the longest line of UTF-8 `text`, to estimate its
+     * width.
+     */
+    DUMP_DECL std::size_t text_columns(string_view text);
+
+    /**
+     * Group a string of bits into bytes separated by spaces, eight bytes
+     * per line.
+     */
+    DUMP_DECL std::string group_bits(string_view bits);
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/format.ipp"
+#endif
+
+#endif //DUMP_FORMAT_HPP
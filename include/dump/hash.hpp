@@ -0,0 +1,111 @@
+#ifndef DUMP_HASH_HPP
+#define DUMP_HASH_HPP
+
+#include "dump/config.hpp"
+#include "dump/traversal.hpp"
+
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace dump {
+
+    /**
+     * Base class for dumpers which compute a structural hash instead of
+     * writing text, see `hash_format`:
+     *
+     *     dump::hash128 hash;
+     *     my_dumper<dump::hash_dumper>{hash}(obj);
+     *
+     * The hash is written when the root dumper is destroyed. Lists with
+     * at least `hash_format::parallel_items` items are split into one
+     * chunk per hardware thread whose items are hashed concurrently, so
+     * the operators of the derived dumper must not modify shared state.
+     */
+    template <typename Derived>
+    struct hash_dumper
+        : private detail::format_storage<hash_format>,
+          public traversal<Derived>
+    {
+        typedef hash_dumper<Derived> Self;
+
+        hash128* result;
+
+        hash_dumper(hash128& result)
+            : traversal<Derived>(this->own()), result(&result) {
+            unsigned const threads = std::thread::hardware_concurrency();
+            this->owned->threads = threads > 0 ? threads : 1;
+        }
+
+        hash_dumper(format_policy& policy)
+            : traversal<Derived>(policy), result(nullptr) {}
+
+        ~hash_dumper() {
+            if(result) {
+                *result = this->owned->digest();
+            }
+        }
+
+        template <typename Container>
+        void cItems(Container const& ops) {
+            hash_format* format = dynamic_cast<hash_format*>(&this->policy);
+            auto const size = ops.size();
+            if(format == nullptr || format->threads < 2
+               || size < format->parallel_items
+               || format->options.collapse_runs || format->selection) {
+                traversal<Derived>::cItems(ops);
+                return;
+            }
+
+            if(this->policy.list_sizes()) {
+                this->template cAttr<Derived>(ops, "size", size, false, true);
+            }
+
+            typedef typename std::remove_reference<
+                decltype(*ops.begin())>::type item_type;
+            std::vector<item_type const*> items;
+            items.reserve(size);
+            for(auto const& op : ops) {
+                items.push_back(std::addressof(op));
+            }
+
+            std::vector<hash128> digests(items.size());
+            std::size_t const chunks = format->threads;
+            std::size_t const chunk = (items.size() + chunks - 1) / chunks;
+            std::vector<std::future<void>> tasks;
+            for(std::size_t first = 0; first < items.size(); first += chunk) {
+                std::size_t const last = first + chunk < items.size()
+                    ? first + chunk : items.size();
+                auto const hash_chunk = [&, first, last] {
+                    hash_format worker;
+                    worker.options = format->options;
+                    worker.pointees = format->pointees;
+                    worker.parallel_items = format->parallel_items;
+                    for(std::size_t i = first; i < last; ++i) {
+                        worker.reset();
+                        traversal<Derived>::template cDispatch<Derived>(
+                            worker, *items[i]);
+                        digests[i] = worker.digest();
+                    }
+                };
+                tasks.push_back(std::async(std::launch::async, hash_chunk));
+            }
+            for(auto& task : tasks) {
+                task.get();
+            }
+
+            for(std::size_t i = 0; i < items.size(); ++i) {
+                attribute const attr{object_ref(ops), "item",
+                                     object_ref(*items[i]),
+                                     i + 1 == items.size(), false, true};
+                format->child(attr, digests[i]);
+            }
+        }
+    };
+
+}
+
+#endif //DUMP_HASH_HPP
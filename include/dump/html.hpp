@@ -0,0 +1,185 @@
+#ifndef DUMP_HTML_HPP
+#define DUMP_HTML_HPP
+
+#include "dump/config.hpp"
+#include "dump/format.hpp"
+#include "dump/traversal.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace dump {
+
+    struct html_options {
+        /**
+         * Title of the page
+         */
+        std::string title = "dump";
+
+        /**
+         * Maximum depth of a node below the first nodes of its chunk.
+         */
+        std::size_t chunk_depth = 3;
+
+        /**
+         * Maximum number of children of a node in one chunk.
+         */
+        std::size_t chunk_children = 100;
+
+        /**
+         * Store the chunks as base64 of gzip instead of plain JSON. They
+         * are decompressed with the `DecompressionStream` of the browser.
+         */
+        bool compress = true;
+    };
+
+    /**
+     * Formatting policy of the html_dumper. Writes a single offline HTML
+     * page with collapsible nodes.
+     *
+     * The nodes are stored as JSON chunks which the script of the page
+     * only parses and renders when a node is opened, so the load time and
+     * the size of the DOM do not depend on the size of the dump. The
+     * remaining children of a node which would exceed the `html_options`
+     * continue in a new chunk. Chunks are written as soon as they are
+     * complete, the first one with the root at the end of the dump.
+     */
+    struct html_format : format_policy {
+        struct frame {
+            bool inlined;
+
+            /**
+             * Whether the text of the node's line is still written.
+             */
+            bool line;
+
+            std::size_t depth;
+
+            /**
+             * Children written to the current chunk
+             */
+            std::size_t children;
+
+            /**
+             * Whether the children continue in a chunk of their own.
+             */
+            bool continued;
+        };
+
+        struct chunk {
+            std::string text;
+            std::size_t id;
+
+            /**
+             * Depth of the first nodes
+             */
+            std::size_t depth;
+        };
+
+        std::ostream& out;
+        html_options options;
+        std::vector<frame> frames;
+
+        /**
+         * Stack of the chunks being written, the first `active` ones are
+         * in use. Closed ones keep their buffers for the next.
+         */
+        std::vector<chunk> chunks;
+        std::size_t active;
+        std::size_t next_id;
+
+        DUMP_DECL explicit html_format(std::ostream& out,
+                                       html_options options = html_options());
+        DUMP_DECL ~html_format();
+
+        html_format(html_format const&) = delete;
+        html_format& operator=(html_format const&) = delete;
+
+        DUMP_DECL void start() override;
+        DUMP_DECL void finish() override;
+
+        DUMP_DECL void enter(attribute const& attr) override;
+        DUMP_DECL void leave(attribute const& attr) override;
+        DUMP_DECL void node(object_ref node, string_view text) override;
+        DUMP_DECL void type(std::type_info const& info) override;
+        DUMP_DECL void addr(void const* address) override;
+        DUMP_DECL void enumeration(string_view text) override;
+        DUMP_DECL void value(string_view text) override;
+        DUMP_DECL void block(string_view text) override;
+
+        DUMP_DECL void bytes(unsigned char const* data,
+                             std::size_t size) override;
+        DUMP_DECL void err(string_view text) override;
+        DUMP_DECL void undefined() override;
+
+    private:
+        bool open;
+
+        /**
+         * JSON of the innermost chunk
+         */
+        DUMP_DECL std::string& text();
+
+        /**
+         * Innermost frame of a node, i.e. which is not inlined.
+         */
+        DUMP_DECL frame& owner();
+
+        /**
+         * Start the line of a new child of the innermost node.
+         */
+        DUMP_DECL void open_node();
+
+        DUMP_DECL void close_node();
+
+        DUMP_DECL void push_chunk(std::size_t depth);
+
+        DUMP_DECL void pop_chunk();
+
+        /**
+         * Make sure the line of the innermost node is still written, or
+         * add a node for a token after its children. Returns whether that
+         * node has to be closed after the token.
+         */
+        DUMP_DECL bool line();
+
+        /**
+         * Append `text` escaped for HTML in a JSON string.
+         */
+        DUMP_DECL void escape(string_view text);
+
+        /**
+         * Append `text` to the line of the innermost node, in a `span` of
+         * class `style`.
+         */
+        DUMP_DECL void write(string_view text, char const* style);
+    };
+
+    /**
+     * Base class for data structure dumpers writing an HTML page.
+     */
+    template <typename Derived>
+    struct html_dumper
+        : private detail::format_storage<html_format>,
+          public traversal<Derived>
+    {
+        typedef html_dumper<Derived> Self;
+
+        html_dumper(std::ostream& out, html_options options = html_options())
+            : traversal<Derived>(this->own(out, std::move(options))) {}
+
+        html_dumper(format_policy& policy)
+            : traversal<Derived>(policy) {}
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/html.ipp"
+#endif
+
+#endif //DUMP_HTML_HPP
@@ -0,0 +1,190 @@
+#ifndef DUMP_IMPL_COMPRESSED_IPP
+#define DUMP_IMPL_COMPRESSED_IPP
+
+#include "dump/compressed.hpp"
+
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace dump {
+
+    /*
+     * Fills chunks on the writing thread and compresses them on its own.
+     */
+    struct compressed_ostream::buffer : std::streambuf {
+        static constexpr std::size_t chunk_size = 1 << 18;
+        static constexpr std::size_t max_chunks = 4;
+
+        std::ostream& sink;
+        compression const codec;
+        int const level;
+
+        std::vector<char> current;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        std::deque<std::vector<char>> chunks;
+        std::vector<std::vector<char>> spare;
+        bool closing = false;
+        std::exception_ptr error;
+
+        std::thread worker;
+
+        buffer(std::ostream& sink, compression codec, int level)
+            : sink(sink), codec(codec), level(level), current(chunk_size) {
+            setp(current.data(), current.data() + current.size());
+            worker = std::thread([this]() { compress(); });
+        }
+
+        /**
+         * Queue the written part of the current chunk and continue with a
+         * spare one.
+         */
+        bool hand_off() {
+            std::size_t const size = pptr() - pbase();
+            if(size == 0) {
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this]() {
+                return chunks.size() < max_chunks || error;
+            });
+            if(error) {
+                // the output is lost anyway
+                setp(current.data(), current.data() + current.size());
+                return false;
+            }
+            current.resize(size);
+            chunks.push_back(std::move(current));
+            if(spare.empty()) {
+                current = std::vector<char>(chunk_size);
+            } else {
+                current = std::move(spare.back());
+                spare.pop_back();
+                current.resize(chunk_size);
+            }
+            lock.unlock();
+            changed.notify_all();
+            setp(current.data(), current.data() + current.size());
+            return true;
+        }
+
+        int_type overflow(int_type c) override {
+            if(!hand_off()) {
+                return traits_type::eof();
+            }
+            if(!traits_type::eq_int_type(c, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(c);
+                pbump(1);
+            }
+            return traits_type::not_eof(c);
+        }
+
+        /*
+         * Partial chunks are kept, the compressed stream can not be read
+         * before it is closed anyway. `std::endl` stays cheap.
+         */
+        int sync() override {
+            std::lock_guard<std::mutex> lock(mutex);
+            return error ? -1 : 0;
+        }
+
+        void compress() {
+            namespace io = boost::iostreams;
+            try {
+                io::filtering_ostream out;
+                if(codec == gzip) {
+                    out.push(io::gzip_compressor(io::gzip_params(
+                        level < 0 ? io::gzip::default_compression : level)));
+                } else if(codec == zstd) {
+                    out.push(io::zstd_compressor(io::zstd_params(
+                        level < 0 ? io::zstd::default_compression
+                                  : static_cast<std::uint32_t>(level))));
+                }
+                out.push(sink);
+
+                std::unique_lock<std::mutex> lock(mutex);
+                while(true) {
+                    changed.wait(lock, [this]() {
+                        return !chunks.empty() || closing;
+                    });
+                    if(chunks.empty()) {
+                        break;
+                    }
+                    std::vector<char> chunk = std::move(chunks.front());
+                    chunks.pop_front();
+                    lock.unlock();
+                    changed.notify_all();
+                    out.write(chunk.data(), chunk.size());
+                    lock.lock();
+                    spare.push_back(std::move(chunk));
+                }
+                lock.unlock();
+                // writes the end of the compressed stream
+                out.reset();
+                sink.flush();
+                if(!sink) {
+                    throw std::ios_base::failure(
+                        "dump::compressed_ostream: can not write the sink");
+                }
+            } catch(...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = std::current_exception();
+                chunks.clear();
+            }
+            changed.notify_all();
+        }
+
+        void close() {
+            if(!worker.joinable()) {
+                return;
+            }
+            hand_off();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                closing = true;
+            }
+            changed.notify_all();
+            worker.join();
+        }
+    };
+
+    DUMP_DECL compressed_ostream::compressed_ostream(std::ostream& sink,
+                                                     compression codec,
+                                                     int level)
+        : std::ostream(nullptr), pending(new buffer(sink, codec, level)) {
+        rdbuf(pending.get());
+    }
+
+    DUMP_DECL compressed_ostream::~compressed_ostream() {
+        try {
+            close();
+        } catch(...) {
+            // reported by `close` only
+        }
+    }
+
+    DUMP_DECL void compressed_ostream::close() {
+        pending->close();
+        if(pending->error) {
+            setstate(std::ios_base::badbit);
+            std::exception_ptr const error = pending->error;
+            pending->error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+}
+
+#endif //DUMP_IMPL_COMPRESSED_IPP
@@ -0,0 +1,102 @@
+#ifndef DUMP_IMPL_CONSOLE_IPP
+#define DUMP_IMPL_CONSOLE_IPP
+
+#include "dump/console.hpp"
+
+namespace dump {
+
+    DUMP_DECL void console_format::enter(attribute const& attr) {
+        if(!attr.inlined) {
+            out << blue;
+            out << '\n';
+            out << prefix;
+            out << (attr.last_child ? '`' : '|');
+            out << "- ";
+            out << reset;
+        } else {
+            out << ' ';
+        }
+        if(attr.label.length() > 0) {
+            out << attr.label << ' ';
+        }
+        push(attr);
+    }
+
+    DUMP_DECL void console_format::node(object_ref node, string_view text) {
+        out << bold << magenta << text << reset;
+    }
+
+    DUMP_DECL void console_format::type(std::type_info const& info) {
+        out << ' ' << yellow << pretty_name(info) << reset;
+    }
+
+    DUMP_DECL void console_format::addr(void const* address) {
+        out << ' ' << cyan << address << reset;
+    }
+
+    DUMP_DECL void console_format::type_addr(std::type_info const& info,
+                                             void const* address) {
+        type(info);
+        addr(address);
+    }
+
+    DUMP_DECL void console_format::enumeration(string_view text) {
+        out << yellow << text << reset;
+    }
+
+    DUMP_DECL void console_format::value(string_view text) {
+        out << green << '\'' << text << '\'' << reset;
+    }
+
+    DUMP_DECL void console_format::string(string_view text) {
+        frame const& current = frames.back();
+        // We expect inlined string attributes to be one liners
+        if(current.inlined) {
+            value(text);
+        } else {
+            out << green;
+            write_lines(out, text, [&](std::ostream& out) {
+                // Reset formatting
+                out << '\n' << reset;
+                // Prefix formatting and prefix content
+                out << blue << prefix;
+                // Label indentation +2 for spaces around
+                write_spaces(out, current.label.size()+2);
+                // Reset formatting again and restore value formatting
+                out << reset << green;
+            });
+            out << reset;
+        }
+    }
+
+    DUMP_DECL void console_format::block(string_view text) {
+        out << '\n' << blue << prefix << "`- " << reset;
+        write_lines(out, text, [this](std::ostream& out) {
+            out << '\n' << blue << prefix << "  " << reset;
+        });
+    }
+
+    DUMP_DECL void console_format::bytes(unsigned char const* data,
+                                         std::size_t size) {
+        out << '\n' << blue << prefix << "`- " << reset;
+        write_hexdump(out, data, size, [this](std::ostream& out) {
+            out << '\n' << blue << prefix << "  " << reset;
+        });
+    }
+
+    DUMP_DECL void console_format::err(string_view text) {
+        out << bold << red << text << reset;
+    }
+
+    DUMP_DECL void console_format::undefined() {
+        out << magenta << "undefined" << reset;
+    }
+
+    DUMP_DECL void console_format::splice(string_view text) {
+        // lines start with the colour of the prefix
+        write_spliced(text, true);
+    }
+
+}
+
+#endif //DUMP_IMPL_CONSOLE_IPP
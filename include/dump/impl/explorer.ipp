@@ -0,0 +1,304 @@
+#ifndef DUMP_IMPL_EXPLORER_IPP
+#define DUMP_IMPL_EXPLORER_IPP
+
+#include "dump/explorer.hpp"
+
+#include <algorithm>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#  include <termios.h>
+#  include <unistd.h>
+#  define DUMP_HAS_TERMIOS
+#endif
+
+namespace dump {
+
+    DUMP_DECL explorer_format::explorer_format(std::ostream& out,
+                                               std::size_t page)
+        : console_format(out), page(page > 0 ? page : 1) {}
+
+    DUMP_DECL void explorer_format::start() {
+        console_format::start();
+        selection = this;
+        entries.clear();
+        entries.push_back(entry{path(), 0, false, true, 0, 0, 0});
+        levels.clear();
+        levels.push_back(level{0, 0, true});
+        current.clear();
+    }
+
+    DUMP_DECL void explorer_format::enter(attribute const& attr) {
+        if(!attr.inlined) {
+            level const& top = levels.back();
+            entries.push_back(entry{current,
+                                    static_cast<std::size_t>(out.tellp()),
+                                    false, top.open, 0, 0, 0});
+        }
+        console_format::enter(attr);
+    }
+
+    DUMP_DECL bool explorer_format::enter(string_view, bool, bool inlined,
+                                          bool&) {
+        level& parent = levels.back();
+        std::size_t const position = parent.children++;
+        if(!parent.open && !inlined) {
+            entries[parent.entry].hidden = true;
+            return false;
+        }
+        current.push_back(position);
+        if(inlined) {
+            // part of the line of the parent
+            levels.push_back(level{0, parent.entry, parent.open});
+        } else {
+            levels.push_back(level{0, entries.size(),
+                                   expanded.count(current) > 0});
+        }
+        return true;
+    }
+
+    DUMP_DECL void explorer_format::leave() {
+        levels.pop_back();
+        current.pop_back();
+    }
+
+    DUMP_DECL void explorer_format::select_items(std::size_t& first,
+                                                 std::size_t& last) {
+        level& top = levels.back();
+        entry& owner = entries[top.entry];
+        if(!top.open) {
+            if(first < last) {
+                owner.hidden = true;
+            }
+            top.children += last - first;
+            first = last;
+            return;
+        }
+        std::size_t const total = last - first;
+        auto const window = windows.find(current);
+        std::size_t skip = window == windows.end() ? 0 : window->second;
+        skip = std::min(skip, total > 0 ? (total - 1) / page * page : 0);
+        if(total > page) {
+            owner.first = skip;
+            owner.last = std::min(skip + page, total);
+            owner.total = total;
+        }
+        first += skip;
+        last = std::min(last, first + page);
+        top.children += skip;
+    }
+
+    DUMP_DECL explorer::explorer(explorer_options options)
+        : options(options), format(text, options.page), cursor(0), top(0) {
+        // the root is always expanded
+        format.expanded.insert(explorer_format::path());
+    }
+
+    DUMP_DECL void explorer::rendered() {
+        std::vector<explorer_format::entry> const& entries = format.entries;
+        for(std::size_t i = 0; i < entries.size(); ++i) {
+            if(entries[i].id == selected) {
+                cursor = i;
+                return;
+            }
+        }
+        // the selected node is gone, stay at the same position
+        cursor = std::min(cursor, entries.size() - 1);
+        selected = entries[cursor].id;
+    }
+
+    DUMP_DECL void explorer::draw(std::ostream& out) {
+        std::string const& output = text.str();
+        std::vector<explorer_format::entry> const& entries = format.entries;
+
+        // rows of every entry with the markers of the selection and
+        // the collapsed nodes in front
+        std::vector<std::string> rows;
+        std::size_t selected_row = 0;
+        for(std::size_t i = 0; i < entries.size(); ++i) {
+            explorer_format::entry const& e = entries[i];
+            std::size_t begin = e.offset;
+            std::size_t const end = i + 1 < entries.size()
+                ? entries[i + 1].offset : output.size();
+            if(i > 0) {
+                // skip the line break of the attribute
+                begin = output.find('\n', begin) + 1;
+            }
+            if(i == cursor) {
+                selected_row = rows.size();
+            }
+            char const marker =
+                e.hidden ? '+' : (e.expanded && i > 0 ? '-' : ' ');
+            std::string row = i == cursor ? "> " : "  ";
+            row += marker;
+            row += ' ';
+            while(true) {
+                std::size_t const next = output.find('\n', begin);
+                if(next == std::string::npos || next >= end) {
+                    row.append(output, begin, end - begin);
+                    break;
+                }
+                row.append(output, begin, next - begin);
+                rows.push_back(row);
+                row = "    ";
+                begin = next + 1;
+            }
+            if(e.total > 0) {
+                row += ' ';
+                row += console_format::yellow;
+                row += "[items " + std::to_string(e.first + 1) + "-"
+                     + std::to_string(e.last) + " of "
+                     + std::to_string(e.total) + "]";
+                row += console_format::reset;
+            }
+            rows.push_back(row);
+        }
+
+        std::size_t const height =
+            options.height > 1 ? options.height - 1 : 1;
+        if(selected_row < top) {
+            top = selected_row;
+        } else if(selected_row >= top + height) {
+            top = selected_row - height + 1;
+        }
+        top = std::min(top, rows.size() - 1);
+
+        // home and clear screen
+        out << "\x1B[H\x1B[2J";
+        std::size_t const last = std::min(rows.size(), top + height);
+        for(std::size_t r = top; r < last; ++r) {
+            out << rows[r] << console_format::reset << '\n';
+        }
+        out << console_format::bold
+            << "j/k move  l expand  h collapse  [/] page  q quit"
+            << console_format::reset << std::flush;
+    }
+
+    DUMP_DECL bool explorer::command(std::istream& in) {
+        int key = in.get();
+        if(key == '\x1B') {
+            // arrow keys are sent as ESC [ A to ESC [ D
+            if(in.get() != '[') {
+                return bool(in);
+            }
+            switch(in.get()) {
+            case 'A':
+                key = 'k';
+                break;
+            case 'B':
+                key = 'j';
+                break;
+            case 'C':
+                key = 'l';
+                break;
+            case 'D':
+                key = 'h';
+                break;
+            default:
+                return bool(in);
+            }
+        }
+
+        std::vector<explorer_format::entry> const& entries = format.entries;
+        explorer_format::entry const& e = entries[cursor];
+        // closest entry above which contains the entry `i`
+        auto const parent = [&entries](std::size_t i) {
+            explorer_format::path const& child = entries[i].id;
+            while(i > 0) {
+                --i;
+                explorer_format::path const& id = entries[i].id;
+                if(id.size() < child.size()
+                   && std::equal(id.begin(), id.end(), child.begin())) {
+                    break;
+                }
+            }
+            return i;
+        };
+        // the list of the entry or the one it is an item of
+        std::size_t list = cursor;
+        while(list > 0 && entries[list].total == 0) {
+            list = parent(list);
+        }
+        explorer_format::entry const& paged = entries[list];
+        switch(key) {
+        case std::char_traits<char>::eof():
+        case 'q':
+            return false;
+        case 'j':
+            if(cursor + 1 < entries.size()) {
+                ++cursor;
+            }
+            break;
+        case 'k':
+            if(cursor > 0) {
+                --cursor;
+            }
+            break;
+        case 'l':
+        case '\n':
+        case '\r':
+            format.expanded.insert(e.id);
+            break;
+        case 'h':
+            if(!e.id.empty() && format.expanded.erase(e.id) == 0) {
+                cursor = parent(cursor);
+            }
+            break;
+        case ']':
+            if(paged.last < paged.total) {
+                format.windows[paged.id] = paged.first + format.page;
+            }
+            break;
+        case '[':
+            if(paged.first > 0) {
+                format.windows[paged.id] = paged.first > format.page
+                    ? paged.first - format.page : 0;
+            }
+            break;
+        default:
+            break;
+        }
+        selected = entries[cursor].id;
+        return true;
+    }
+
+#if defined(DUMP_HAS_TERMIOS)
+
+    struct raw_terminal::settings {
+        termios attributes;
+    };
+
+    DUMP_DECL raw_terminal::raw_terminal() {
+        termios attributes;
+        if(!isatty(STDIN_FILENO)
+           || tcgetattr(STDIN_FILENO, &attributes) != 0) {
+            return;
+        }
+        saved.reset(new settings{attributes});
+        attributes.c_lflag &= ~(ICANON | ECHO);
+        attributes.c_cc[VMIN] = 1;
+        attributes.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &attributes);
+    }
+
+    DUMP_DECL raw_terminal::~raw_terminal() {
+        if(saved) {
+            tcsetattr(STDIN_FILENO, TCSANOW, &saved->attributes);
+        }
+    }
+
+#else
+
+    struct raw_terminal::settings {};
+
+    DUMP_DECL raw_terminal::raw_terminal() {}
+
+    DUMP_DECL raw_terminal::~raw_terminal() {}
+
+#endif
+
+}
+
+#undef DUMP_HAS_TERMIOS
+
+#endif //DUMP_IMPL_EXPLORER_IPP
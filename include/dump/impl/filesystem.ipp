@@ -0,0 +1,165 @@
+#ifndef DUMP_IMPL_FILESYSTEM_IPP
+#define DUMP_IMPL_FILESYSTEM_IPP
+
+#include "dump/filesystem.hpp"
+#include "dump/compressed.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace dump {
+
+    namespace detail {
+
+        /*
+         * Unique temporary file next to `path`, renamed to it when done.
+         */
+        inline boost::filesystem::path partial_path(std::string const& path) {
+            return path + boost::filesystem::unique_path(
+                ".%%%%-%%%%-%%%%.partial").string();
+        }
+
+        inline bool same_content(boost::filesystem::path const& a,
+                                 boost::filesystem::path const& b) {
+            boost::system::error_code error;
+            auto const size = boost::filesystem::file_size(b, error);
+            if(error || boost::filesystem::file_size(a, error) != size
+               || error) {
+                return false;
+            }
+            std::ifstream first(a.string(), std::ios::binary);
+            std::ifstream second(b.string(), std::ios::binary);
+            char left[1 << 14];
+            char right[1 << 14];
+            while(first && second) {
+                first.read(left, sizeof(left));
+                second.read(right, sizeof(right));
+                std::streamsize const n = first.gcount();
+                if(n != second.gcount() || std::memcmp(left, right, n) != 0) {
+                    return false;
+                }
+            }
+            return first.eof() && second.eof();
+        }
+
+    }
+
+    DUMP_DECL std::string fs_path(std::string const& project,
+                                  std::string const& artifact,
+                                  std::string const& type,
+                                  std::string const& extension) {
+        auto path = boost::filesystem::temp_directory_path()
+            / (project + "_" + artifact + "_" + type + extension);
+        return path.string();
+    }
+
+    DUMP_DECL std::string fs_path(std::string const& directory,
+                                  std::string const& project,
+                                  std::string const& artifact,
+                                  std::string const& type,
+                                  std::string const& extension) {
+        if(directory.empty()) {
+            return fs_path(project, artifact, type, extension);
+        }
+        auto path = boost::filesystem::path(directory)
+            / (project + "_" + artifact + "_" + type + extension);
+        return path.string();
+    }
+
+    DUMP_DECL bool fs_write(std::string const& path,
+                            std::string const& content) {
+        namespace fs = boost::filesystem;
+        boost::system::error_code error;
+        if(fs::file_size(path, error) == content.size() && !error) {
+            std::ifstream in(path, std::ios::binary);
+            std::string existing(content.size(), '\0');
+            if(in.read(&existing[0], existing.size()) && existing == content) {
+                return false;
+            }
+        }
+
+        fs::path const partial = detail::partial_path(path);
+        try {
+            {
+                std::ofstream out(partial.string(), std::ios::binary);
+                out.write(content.data(), content.size());
+                if(!out.flush()) {
+                    throw std::runtime_error(
+                        "dump::fs_write: can not write '"
+                        + partial.string() + "'");
+                }
+            }
+            fs::rename(partial, path);
+        } catch(...) {
+            fs::remove(partial, error);
+            throw;
+        }
+        return true;
+    }
+
+    struct fs_output::state {
+        std::string path;
+        boost::filesystem::path partial;
+        std::ofstream file;
+        std::unique_ptr<compressed_ostream> compressed;
+        bool committed = false;
+    };
+
+    DUMP_DECL fs_output::fs_output(std::string const& path, compression codec)
+        : pending(new state) {
+        pending->path = path;
+        pending->partial = detail::partial_path(path);
+        pending->file.open(pending->partial.string(), std::ios::binary);
+        if(!pending->file) {
+            throw std::runtime_error("dump::fs_output: can not open '"
+                                     + pending->partial.string() + "'");
+        }
+        if(codec != uncompressed) {
+            pending->compressed.reset(
+                new compressed_ostream(pending->file, codec));
+        }
+    }
+
+    DUMP_DECL fs_output::~fs_output() {
+        if(!pending->committed) {
+            pending->compressed.reset();
+            pending->file.close();
+            boost::system::error_code error;
+            boost::filesystem::remove(pending->partial, error);
+        }
+    }
+
+    DUMP_DECL std::ostream& fs_output::stream() {
+        if(pending->compressed) {
+            return *pending->compressed;
+        }
+        return pending->file;
+    }
+
+    DUMP_DECL bool fs_output::commit() {
+        namespace fs = boost::filesystem;
+        if(pending->compressed) {
+            pending->compressed->close();
+        }
+        pending->file.close();
+        if(!pending->file) {
+            throw std::runtime_error("dump::fs_output: can not write '"
+                                     + pending->partial.string() + "'");
+        }
+        bool const changed = !detail::same_content(pending->partial,
+                                                   pending->path);
+        if(changed) {
+            fs::rename(pending->partial, pending->path);
+        } else {
+            fs::remove(pending->partial);
+        }
+        pending->committed = true;
+        return changed;
+    }
+
+}
+
+#endif //DUMP_IMPL_FILESYSTEM_IPP
@@ -0,0 +1,338 @@
+#ifndef DUMP_IMPL_FOREST_IPP
+#define DUMP_IMPL_FOREST_IPP
+
+#include "dump/forest.hpp"
+#include "dump/latex_support.hpp"
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+namespace dump {
+
+    DUMP_DECL forest_format::forest_format(std::ostream& out,
+                                           forest_split split)
+        : out(out), split(split), first(nullptr), active(0), open(false),
+          in_node(false), lines(0), top(0), next_node(0) {
+        start();
+    }
+
+    DUMP_DECL forest_format::forest_format(std::ostream& out,
+                                           forest_layout layout)
+        : out(out), layout(layout), first(nullptr), active(0), open(false),
+          in_node(false), lines(0), top(0), next_node(0) {
+        start();
+    }
+
+    DUMP_DECL forest_format::~forest_format() {
+        finish();
+    }
+
+    DUMP_DECL void forest_format::start() {
+        format_policy::start();
+        first = out.rdbuf();
+        active = 0;
+        if(environments.empty()) {
+            environments.push_back(environment{nullptr, 1, 0, 0});
+        }
+        // continued environments of the previous dump
+        environments.erase(environments.begin() + 1, environments.end());
+        environments.front().nodes = 1;
+        frames.clear();
+        frames.push_back(frame{"", false, 0, 0, 0, 0, 0});
+        in_node = false;
+        top = 0;
+        next_node = 0;
+        print_prefix(frames.back());
+        if(split.max_nodes > 0 || split.max_depth > 0) {
+            out << "\\hypertarget{dump-forest-0}{}";
+        }
+        open = true;
+    }
+
+    DUMP_DECL void forest_format::finish() {
+        if(!open) {
+            return;
+        }
+        open = false;
+        frame const& root = frames.front();
+        if(root.child_environment != root.environment) {
+            close_environment(root.child_environment);
+        }
+        activate(root.environment);
+        print_postfix(root);
+        for(std::size_t i = 1; i < environments.size(); ++i) {
+            out << environments[i].buffer->str();
+        }
+    }
+
+    DUMP_DECL std::string forest_format::escape(string_view text) {
+        std::ostringstream oss;
+        write_forest_escaped(oss, text);
+        return oss.str();
+    }
+
+    DUMP_DECL void forest_format::print_escaped(string_view text) {
+        write_forest_escaped(out, text);
+    }
+
+    DUMP_DECL void forest_format::print_prefix(frame const& current) {
+        if(layout) {
+            if(current.level == 0) {
+                write_forest_layout_preamble(out);
+            }
+            if(!current.inlined) {
+                open_node(frames.size() - 1);
+            } else {
+                continue_node();
+                out << ' ';
+            }
+            if(current.label.length() > 0) {
+                print_escaped(current.label);
+                out << ' ';
+            }
+            return;
+        }
+        if(current.level == 0) {
+            write_forest_preamble(out);
+        }
+        if(!current.inlined) {
+            write_spaces(out, current.level
+                              - environments[current.environment].level);
+            out << "[";
+        } else {
+            out << ' ';
+        }
+        if(current.label.length() > 0) {
+            print_escaped(current.label);
+            out << ' ';
+        }
+    }
+
+    DUMP_DECL void forest_format::print_postfix(frame const& current) {
+        if(layout) {
+            if(!current.inlined) {
+                close_node();
+            } else if(in_node) {
+                out << ' ';
+            }
+            if(current.level == 0) {
+                out << "\\end{tikzpicture}\n";
+            }
+            return;
+        }
+        if(!current.inlined) {
+            out << "]\n";
+        } else {
+            out << ' ';
+        }
+        if(current.level == 0) {
+            out << "\\end{forest}\n";
+        }
+    }
+
+    DUMP_DECL bool forest_format::must_split(std::size_t index) const {
+        frame const& parent = frames[index];
+        environment const& current =
+            environments[parent.child_environment];
+        // continued environments keep at least one child
+        bool const continued = parent.child_environment
+                               != parent.environment;
+        if(split.max_nodes > 0 && current.nodes >= split.max_nodes
+           && !(continued && current.nodes <= 1)) {
+            return true;
+        }
+        return split.max_depth > 0
+            && parent.level + 1 - current.level > split.max_depth;
+    }
+
+    DUMP_DECL void forest_format::split_children(std::size_t index) {
+        std::size_t const from = frames[index].child_environment;
+        std::size_t const to = environments.size();
+        unsigned int const level = frames[index].level;
+        environments.push_back(environment{
+            std::unique_ptr<std::stringbuf>(new std::stringbuf()),
+            1, level, index});
+
+        activate(from);
+        write_spaces(out, level + 1 - environments[from].level);
+        out << "[\\hyperlink{dump-forest-" << to << "}{$\\rightarrow$~"
+            << to << "}]\n";
+        if(environments[from].owner == index && from != 0) {
+            close_environment(from);
+        }
+        frames[index].child_environment = to;
+
+        activate(to);
+        write_forest_preamble(out);
+        out << "[\\hypertarget{dump-forest-" << to << "}{}\\hyperlink{"
+            << "dump-forest-" << frames[index].environment
+            << "}{$\\leftarrow$~" << to << "} ";
+        print_escaped(frames[index].label);
+        out << '\n';
+    }
+
+    DUMP_DECL void forest_format::close_environment(std::size_t index) {
+        activate(index);
+        out << "]\n\\end{forest}\n";
+    }
+
+    DUMP_DECL void forest_format::activate(std::size_t index) {
+        if(index != active) {
+            out.rdbuf(index == 0 ? first : environments[index].buffer.get());
+            active = index;
+        }
+    }
+
+    DUMP_DECL void forest_format::open_node(std::size_t index) {
+        close_node();
+        frame const& current = frames[index];
+        char position[64];
+        std::snprintf(position, sizeof(position), "(%.2fpt,%.2fpt)",
+                      current.depth * layout->indent, 0 - top);
+        out << "\\node (dump-forest-" << next_node << ") at " << position
+            << " {";
+        in_node = true;
+        lines = 1;
+        ++next_node;
+    }
+
+    DUMP_DECL void forest_format::close_node() {
+        if(!in_node) {
+            return;
+        }
+        out << "};\n";
+        in_node = false;
+        top += lines * layout->line_height + 2 * layout->inner_sep
+            + layout->spacing;
+    }
+
+    DUMP_DECL void forest_format::continue_node() {
+        if(layout && !in_node) {
+            open_node(frames.size() - 1);
+        }
+    }
+
+    DUMP_DECL void forest_format::enter(attribute const& attr) {
+        std::size_t const parent = frames.size() - 1;
+        if(!attr.inlined && !layout && must_split(parent)) {
+            split_children(parent);
+        }
+        std::size_t const current = frames[parent].child_environment;
+        activate(current);
+        if(!attr.inlined) {
+            ++environments[current].nodes;
+        }
+        frame const& outer = frames[parent];
+        frames.push_back(frame{attr.label, attr.inlined, outer.level + 1,
+                               current, current,
+                               attr.inlined ? outer.node : next_node,
+                               outer.depth + (attr.inlined ? 0 : 1)});
+        print_prefix(frames.back());
+    }
+
+    DUMP_DECL void forest_format::leave(attribute const& attr) {
+        frame const& current = frames.back();
+        if(current.child_environment != current.environment) {
+            close_environment(current.child_environment);
+        }
+        activate(current.environment);
+        print_postfix(current);
+        if(layout && !current.inlined) {
+            // the edge style of `write_forest_preamble`
+            out << "\\draw ([xshift=" << layout->indent / 2
+                << "pt]dump-forest-" << frames[frames.size() - 2].node
+                << ".south west) |- node[fill, inner sep=1.25pt,"
+                   " anchor=center] {} (dump-forest-" << current.node
+                << ".west);\n";
+        }
+        frames.pop_back();
+        activate(frames.back().environment);
+    }
+
+    DUMP_DECL void forest_format::node(object_ref node, string_view text) {
+        continue_node();
+        out << bold << magenta;
+        print_escaped(text);
+        out << reset << reset;
+    }
+
+    DUMP_DECL void forest_format::type(std::type_info const& info) {
+        continue_node();
+        // alternatively use info.name() which is not required to be
+        // human readable
+        out << ' ' << yellow;
+        print_escaped(pretty_name(info));
+        out << reset;
+    }
+
+    DUMP_DECL void forest_format::addr(void const* address) {
+        continue_node();
+        out << ' ' << cyan << address << reset;
+    }
+
+    DUMP_DECL void forest_format::enumeration(string_view text) {
+        continue_node();
+        out << yellow;
+        print_escaped(text);
+        out << reset;
+    }
+
+    DUMP_DECL void forest_format::value(string_view text) {
+        continue_node();
+        // TODO: Support multi line strings as in `console_format`
+        if(text.find('\n') == string_view::npos) {
+            out << green << ' ';
+            print_escaped(text);
+            out << ' ' << reset;
+        } else {
+            block(text);
+        }
+    }
+
+    DUMP_DECL void forest_format::block(string_view text) {
+        continue_node();
+        std::string t =
+            boost::replace_all_copy(escape(text),
+                                    "\n",
+                                    "\\\\\n  ");
+        boost::replace_all(t, " ", "\\ ");
+        boost::replace_all(t, "/home/chris/projects/thesis/code/umbrella/", "");
+        boost::replace_all(t, "lib-udf-clang-sdf-sdf-col/test/src/", "");
+        out << "\\\\\n\\ \\ " << t;
+        if(layout) {
+            lines += 1 + std::count(text.begin(), text.end(), '\n');
+        } else {
+            out << ", align=left";
+        }
+    }
+
+    DUMP_DECL void forest_format::bytes(unsigned char const* data,
+                                        std::size_t size) {
+        continue_node();
+        out << "\\\\\n";
+        write_latex_hexdump(out, data, size);
+        if(layout) {
+            lines += (size + 15) / 16;
+        } else {
+            out << ", align=left";
+        }
+    }
+
+    DUMP_DECL void forest_format::err(string_view text) {
+        continue_node();
+        out << bold << red;
+        print_escaped(text);
+        out << reset;
+    }
+
+    DUMP_DECL void forest_format::undefined() {
+        continue_node();
+        out << violet << "undefined" << reset;
+    }
+
+}
+
+#endif //DUMP_IMPL_FOREST_IPP
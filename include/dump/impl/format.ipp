@@ -0,0 +1,243 @@
+#ifndef DUMP_IMPL_FORMAT_IPP
+#define DUMP_IMPL_FORMAT_IPP
+
+#include "dump/format.hpp"
+
+#include <boost/core/demangle.hpp>
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+namespace dump {
+
+    namespace detail {
+        inline string_view
+        format_number(number_buffer& buffer, char const* format, ...) {
+            va_list args;
+            va_start(args, format);
+            int length = std::vsnprintf(buffer.data, sizeof(buffer.data),
+                                        format, args);
+            va_end(args);
+            if(length < 0) {
+                length = 0;
+            } else if(static_cast<std::size_t>(length) >= sizeof(buffer.data)) {
+                length = sizeof(buffer.data) - 1;
+            }
+            return string_view(buffer.data, length);
+        }
+    }
+
+    DUMP_DECL string_view format(number_buffer& buffer, int value) {
+        return detail::format_number(buffer, "%d", value);
+    }
+
+    DUMP_DECL string_view format(number_buffer& buffer, unsigned int value) {
+        return detail::format_number(buffer, "%u", value);
+    }
+
+    DUMP_DECL string_view format(number_buffer& buffer, long value) {
+        return detail::format_number(buffer, "%ld", value);
+    }
+
+    DUMP_DECL string_view format(number_buffer& buffer, unsigned long value) {
+        return detail::format_number(buffer, "%lu", value);
+    }
+
+    DUMP_DECL string_view format(number_buffer& buffer, double value) {
+        return detail::format_number(buffer, "%f", value);
+    }
+
+    DUMP_DECL std::string pretty_name(std::type_info const& type) {
+        return boost::core::demangle(type.name());
+    }
+
+    DUMP_DECL void hex_encode(char* out, unsigned char const* data,
+                              std::size_t size) {
+        static char const digits[] = "0123456789abcdef";
+        std::size_t i = 0;
+#if defined(__SSE2__)
+        __m128i const low_mask = _mm_set1_epi8(0x0f);
+        __m128i const nine = _mm_set1_epi8(9);
+        __m128i const zero = _mm_set1_epi8('0');
+        // distance between '9'+1 and 'a'
+        __m128i const letters = _mm_set1_epi8('a' - '0' - 10);
+        for(; size - i >= 16; i += 16) {
+            __m128i const x = _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(data + i));
+            __m128i const high = _mm_and_si128(_mm_srli_epi16(x, 4),
+                                               low_mask);
+            __m128i const low = _mm_and_si128(x, low_mask);
+            __m128i const first = _mm_unpacklo_epi8(high, low);
+            __m128i const second = _mm_unpackhi_epi8(high, low);
+            __m128i const first_hex = _mm_add_epi8(
+                _mm_add_epi8(first, zero),
+                _mm_and_si128(_mm_cmpgt_epi8(first, nine), letters));
+            __m128i const second_hex = _mm_add_epi8(
+                _mm_add_epi8(second, zero),
+                _mm_and_si128(_mm_cmpgt_epi8(second, nine), letters));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i),
+                             first_hex);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16),
+                             second_hex);
+        }
+#endif
+        for(; i < size; ++i) {
+            out[2 * i] = digits[data[i] >> 4];
+            out[2 * i + 1] = digits[data[i] & 0x0f];
+        }
+    }
+
+    DUMP_DECL std::size_t hexdump_line(char* line, std::size_t offset,
+                                       unsigned char const* data,
+                                       std::size_t size) {
+        // 00000000  00 01 02 03 04 05 06 07  08 09 0a 0b 0c 0d 0e 0f  |................|
+        char hex[32];
+        hex_encode(hex, data, size);
+        std::memset(line, ' ', 60);
+        for(int i = 7; i >= 0; --i) {
+            line[i] = "0123456789abcdef"[offset & 0x0f];
+            offset >>= 4;
+        }
+        for(std::size_t i = 0; i < size; ++i) {
+            char* byte = line + 10 + 3 * i + (i >= 8 ? 1 : 0);
+            byte[0] = hex[2 * i];
+            byte[1] = hex[2 * i + 1];
+        }
+        char* ascii = line + 60;
+        *ascii++ = '|';
+        for(std::size_t i = 0; i < size; ++i) {
+            *ascii++ = (data[i] >= 0x20 && data[i] < 0x7f)
+                ? static_cast<char>(data[i]) : '.';
+        }
+        *ascii++ = '|';
+        return ascii - line;
+    }
+
+    DUMP_DECL string_view truncate(std::string& buffer, string_view text,
+                                   std::size_t max_chars,
+                                   std::size_t max_lines) {
+        std::size_t const size = text.size();
+        if((max_chars == 0 || size <= max_chars)
+           && (max_lines == 0 || size < max_lines)) {
+            // short enough without counting lines
+            return text;
+        }
+
+        // keep [0, head) and [tail, size)
+        std::size_t head = size;
+        if(max_chars > 0 && size > max_chars) {
+            head = max_chars - max_chars / 2;
+        }
+        std::size_t tail = max_chars > 0 && size - head > max_chars / 2
+            ? size - max_chars / 2 : head;
+
+        if(max_lines > 0) {
+            std::size_t const head_lines = max_lines - max_lines / 2;
+            std::size_t const tail_lines = max_lines / 2;
+            std::size_t lines = 0;
+            std::size_t end = 0;
+            while(lines < head_lines) {
+                std::size_t const found = text.find('\n', end);
+                if(found == string_view::npos || found >= head) {
+                    break;
+                }
+                end = found + 1;
+                ++lines;
+            }
+            if(lines == head_lines && end < head) {
+                head = end;
+                tail = max_chars > 0 && size - head > max_chars / 2
+                    ? size - max_chars / 2 : head;
+                // the last tail_lines lines, ignoring a final line break
+                std::size_t start = size;
+                std::size_t search = size > 0 && text[size-1] == '\n'
+                    ? size - 1 : size;
+                lines = 0;
+                while(lines < tail_lines && search > tail) {
+                    std::size_t const found = text.rfind('\n', search - 1);
+                    if(found == string_view::npos || found < tail) {
+                        break;
+                    }
+                    start = found + 1;
+                    search = found;
+                    ++lines;
+                }
+                if(lines == tail_lines) {
+                    tail = start;
+                }
+            }
+        }
+        if(tail <= head) {
+            return text;
+        }
+
+        // do not split UTF-8 sequences
+        while(head > 0 && (static_cast<unsigned char>(text[head]) & 0xc0)
+                          == 0x80) {
+            --head;
+        }
+        while(tail < size && (static_cast<unsigned char>(text[tail]) & 0xc0)
+                             == 0x80) {
+            ++tail;
+        }
+
+        number_buffer digits;
+        string_view const& elided =
+            format(digits, static_cast<unsigned long>(tail - head));
+        buffer.assign(text.data(), head);
+        buffer += "\xe2\x80\xa6("; // U+2026 horizontal ellipsis
+        buffer.append(elided.data(), elided.size());
+        buffer += " bytes elided)";
+        if(tail > 0 && text[tail-1] == '\n') {
+            // the tail starts a line
+            buffer += '\n';
+        }
+        buffer.append(text.data() + tail, size - tail);
+        return buffer;
+    }
+
+    DUMP_DECL std::size_t text_columns(string_view text) {
+        std::size_t longest = 0;
+        std::size_t columns = 0;
+        for(char c : text) {
+            if(c == '\n') {
+                columns = 0;
+            } else if((static_cast<unsigned char>(c) & 0xC0) != 0x80) {
+                // not a continuation byte
+                longest = std::max(longest, ++columns);
+            }
+        }
+        return longest;
+    }
+
+    DUMP_DECL std::string group_bits(string_view bits) {
+        std::string grouped;
+        grouped.reserve(bits.size() + bits.size() / 8);
+        for(std::size_t i = 0; i < bits.size(); ++i) {
+            if(i > 0 && i % 8 == 0) {
+                grouped += (i % 64 == 0 ? '\n' : ' ');
+            }
+            grouped += bits[i];
+        }
+        return grouped;
+    }
+
+    DUMP_DECL void write_spaces(std::ostream& out, std::size_t count) {
+        static char const spaces[] = "                                ";
+        while(count > 0) {
+            std::size_t n = count < sizeof(spaces) - 1
+                ? count : sizeof(spaces) - 1;
+            out.write(spaces, n);
+            count -= n;
+        }
+    }
+
+}
+
+#endif //DUMP_IMPL_FORMAT_IPP
@@ -0,0 +1,429 @@
+#ifndef DUMP_IMPL_HTML_IPP
+#define DUMP_IMPL_HTML_IPP
+
+#include "dump/html.hpp"
+
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <cstdio>
+
+namespace dump {
+
+    namespace detail {
+
+        DUMP_DECL void write_base64(std::ostream& out, string_view data) {
+            static char const digits[] =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+                "0123456789+/";
+            char quad[4];
+            std::size_t i = 0;
+            for(; i + 3 <= data.size(); i += 3) {
+                unsigned long const n =
+                    static_cast<unsigned char>(data[i]) << 16
+                    | static_cast<unsigned char>(data[i + 1]) << 8
+                    | static_cast<unsigned char>(data[i + 2]);
+                quad[0] = digits[n >> 18 & 63];
+                quad[1] = digits[n >> 12 & 63];
+                quad[2] = digits[n >> 6 & 63];
+                quad[3] = digits[n & 63];
+                out.write(quad, 4);
+            }
+            if(i < data.size()) {
+                unsigned long n = static_cast<unsigned char>(data[i]) << 16;
+                if(i + 1 < data.size()) {
+                    n |= static_cast<unsigned char>(data[i + 1]) << 8;
+                }
+                quad[0] = digits[n >> 18 & 63];
+                quad[1] = digits[n >> 12 & 63];
+                quad[2] = i + 1 < data.size() ? digits[n >> 6 & 63] : '=';
+                quad[3] = '=';
+                out.write(quad, 4);
+            }
+        }
+
+        /*
+         * Nodes are created by the script when their parent is opened. The
+         * children of a node continue in the chunks of its `{"k": id}`
+         * children, which are loaded when it is opened, or on a click if
+         * they are further children (`"m"`) of a long list.
+         */
+        constexpr char const* html_script = R"(<script>
+(function() {
+  function load(id) {
+    var chunk = document.getElementById('dump-' + id);
+    if(chunk.dataset.encoding == 'json') {
+      return Promise.resolve(JSON.parse(chunk.textContent));
+    }
+    var data = atob(chunk.textContent);
+    var bytes = new Uint8Array(data.length);
+    for(var i = 0; i < data.length; ++i) {
+      bytes[i] = data.charCodeAt(i);
+    }
+    var text = new Blob([bytes]).stream()
+      .pipeThrough(new DecompressionStream('gzip'));
+    return new Response(text).text().then(JSON.parse);
+  }
+  function expand(reference, parent) {
+    load(reference.k).then(function(nodes) {
+      var children = document.createDocumentFragment();
+      render(nodes, children);
+      parent.replaceWith(children);
+    });
+  }
+  function render(nodes, parent) {
+    nodes.forEach(function(node) {
+      if(node.k !== undefined) {
+        var more = document.createElement('div');
+        more.className = 'more';
+        more.textContent = '…';
+        parent.appendChild(more);
+        if(node.m) {
+          more.onclick = function() { expand(node, more); };
+        } else {
+          expand(node, more);
+        }
+      } else if(node.c === undefined) {
+        var leaf = document.createElement('div');
+        leaf.className = 'leaf';
+        leaf.innerHTML = node.h;
+        parent.appendChild(leaf);
+      } else {
+        var details = document.createElement('details');
+        var summary = document.createElement('summary');
+        summary.innerHTML = node.h;
+        details.appendChild(summary);
+        details.addEventListener('toggle', function() {
+          if(details.open && !details.rendered) {
+            details.rendered = true;
+            render(node.c, details);
+          }
+        });
+        parent.appendChild(details);
+      }
+    });
+  }
+  load(0).then(function(nodes) {
+    var root = document.getElementById('dump');
+    render(nodes, root);
+    var first = root.querySelector('details');
+    if(first) {
+      first.open = true;
+    }
+  });
+})();
+</script>
+)";
+
+        constexpr char const* html_style = R"(<style>
+body { font-family: monospace; }
+details > :not(summary) { margin-left: 1.5em; }
+.leaf, .more { margin-left: 1.1em; }
+.more { cursor: pointer; color: gray; }
+.l { color: navy; }
+.n { color: darkmagenta; font-weight: bold; }
+.t { color: darkorange; }
+.a { color: darkcyan; }
+.e { color: darkorange; }
+.v { color: green; }
+.x { color: red; font-weight: bold; }
+.u { color: darkmagenta; }
+pre { margin: 0; }
+</style>
+)";
+
+    }
+
+    DUMP_DECL html_format::html_format(std::ostream& out,
+                                       html_options options)
+        : out(out), options(std::move(options)), active(0), next_id(0),
+          open(false) {
+        start();
+    }
+
+    DUMP_DECL html_format::~html_format() {
+        finish();
+    }
+
+    DUMP_DECL void html_format::start() {
+        format_policy::start();
+        frames.clear();
+        active = 0;
+        next_id = 0;
+
+        out << "<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n"
+            << "<title>";
+        for(char c : options.title) {
+            switch(c) {
+            case '&':
+                out << "&amp;";
+                break;
+            case '<':
+                out << "&lt;";
+                break;
+            default:
+                out << c;
+                break;
+            }
+        }
+        out << "</title>\n" << detail::html_style << "</head>\n<body>\n"
+            << "<div id=\"dump\"></div>\n";
+
+        push_chunk(0);
+        frames.push_back(frame{false, true, 0, 0, false});
+        text() += "{\"h\":\"";
+        open = true;
+    }
+
+    DUMP_DECL void html_format::finish() {
+        if(!open) {
+            return;
+        }
+        open = false;
+        close_node();
+        pop_chunk();
+        out << detail::html_script << "</body>\n</html>\n";
+    }
+
+    DUMP_DECL std::string& html_format::text() {
+        return chunks[active - 1].text;
+    }
+
+    DUMP_DECL html_format::frame& html_format::owner() {
+        std::size_t i = frames.size() - 1;
+        while(frames[i].inlined) {
+            --i;
+        }
+        return frames[i];
+    }
+
+    DUMP_DECL void html_format::push_chunk(std::size_t depth) {
+        if(active == chunks.size()) {
+            chunks.emplace_back();
+        }
+        chunk& c = chunks[active++];
+        c.text.clear();
+        c.text += '[';
+        c.id = next_id++;
+        c.depth = depth;
+    }
+
+    DUMP_DECL void html_format::pop_chunk() {
+        chunk& c = chunks[--active];
+        c.text += ']';
+        out << "<script type=\"application/x-dump-chunk\" id=\"dump-"
+            << c.id << "\" data-encoding=\""
+            << (options.compress ? "gzip" : "json") << "\">";
+        if(options.compress) {
+            namespace io = boost::iostreams;
+            std::string compressed;
+            {
+                io::filtering_ostream gzip;
+                gzip.push(io::gzip_compressor());
+                gzip.push(io::back_inserter(compressed));
+                gzip.write(c.text.data(), c.text.size());
+            }
+            detail::write_base64(out, compressed);
+        } else {
+            // the text has no '<' besides the markup of the lines, which
+            // can not end the script
+            out << c.text;
+        }
+        out << "</script>\n";
+    }
+
+    DUMP_DECL void html_format::open_node() {
+        frame& parent = owner();
+        std::size_t const depth = parent.depth + 1;
+        if(parent.line) {
+            text() += "\",\"c\":[";
+            parent.line = false;
+        }
+
+        std::size_t const max_children = options.chunk_children;
+        bool const full = max_children > 0
+            && parent.children >= max_children;
+        if(parent.continued && full) {
+            // further children of a long list, linked from the end of the
+            // previous ones
+            text() += ",{\"k\":" + std::to_string(next_id) + ",\"m\":1}";
+            pop_chunk();
+            push_chunk(depth);
+            parent.children = 0;
+        } else if(!parent.continued
+                  && (full || (options.chunk_depth > 0
+                               && depth - chunks[active - 1].depth
+                                  >= options.chunk_depth))) {
+            if(parent.children > 0) {
+                text() += ",{\"k\":" + std::to_string(next_id) + ",\"m\":1}";
+            } else {
+                text() += "{\"k\":" + std::to_string(next_id) + "}";
+            }
+            push_chunk(depth);
+            parent.continued = true;
+            parent.children = 0;
+        } else if(parent.children > 0) {
+            text() += ',';
+        }
+        ++parent.children;
+
+        text() += "{\"h\":\"";
+        frames.push_back(frame{false, true, depth, 0, false});
+    }
+
+    DUMP_DECL void html_format::close_node() {
+        frame const& done = frames.back();
+        if(done.continued) {
+            pop_chunk();
+        }
+        text() += done.line ? "\"}" : "]}";
+        frames.pop_back();
+    }
+
+    DUMP_DECL bool html_format::line() {
+        if(owner().line) {
+            return false;
+        }
+        open_node();
+        return true;
+    }
+
+    DUMP_DECL void html_format::escape(string_view text) {
+        std::string& json = this->text();
+        for(char c : text) {
+            switch(c) {
+            case '&':
+                json += "&amp;";
+                break;
+            case '<':
+                json += "&lt;";
+                break;
+            case '>':
+                json += "&gt;";
+                break;
+            case '"':
+                json += "&quot;";
+                break;
+            case '\\':
+                json += "\\\\";
+                break;
+            case '\n':
+                json += "\\n";
+                break;
+            case '\t':
+                json += "\\t";
+                break;
+            default:
+                if(static_cast<unsigned char>(c) < 0x20) {
+                    char code[7];
+                    std::snprintf(code, sizeof(code), "\\u%04x",
+                                  static_cast<unsigned int>(c));
+                    json += code;
+                } else {
+                    json += c;
+                }
+                break;
+            }
+        }
+    }
+
+    DUMP_DECL void html_format::write(string_view text, char const* style) {
+        bool const stray = line();
+        std::string& json = this->text();
+        json += "<span class=";
+        json += style;
+        json += '>';
+        escape(text);
+        this->text() += "</span>";
+        if(stray) {
+            close_node();
+        }
+    }
+
+    DUMP_DECL void html_format::enter(attribute const& attr) {
+        if(attr.inlined && owner().line) {
+            frames.push_back(frame{true, true, 0, 0, false});
+            text() += ' ';
+        } else {
+            // inlined attributes after the children get a line of their own
+            open_node();
+        }
+        if(attr.label.length() > 0) {
+            write(attr.label, "l");
+            text() += ' ';
+        }
+    }
+
+    DUMP_DECL void html_format::leave(attribute const& attr) {
+        if(frames.back().inlined) {
+            frames.pop_back();
+        } else {
+            close_node();
+        }
+    }
+
+    DUMP_DECL void html_format::node(object_ref node, string_view text) {
+        write(text, "n");
+    }
+
+    DUMP_DECL void html_format::type(std::type_info const& info) {
+        text() += ' ';
+        write(pretty_name(info), "t");
+    }
+
+    DUMP_DECL void html_format::addr(void const* address) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%p", address);
+        text() += ' ';
+        write(buffer, "a");
+    }
+
+    DUMP_DECL void html_format::enumeration(string_view text) {
+        write(text, "e");
+    }
+
+    DUMP_DECL void html_format::value(string_view text) {
+        write(text, "v");
+    }
+
+    DUMP_DECL void html_format::block(string_view text) {
+        bool const stray = line();
+        this->text() += "<pre>";
+        escape(text);
+        this->text() += "</pre>";
+        if(stray) {
+            close_node();
+        }
+    }
+
+    DUMP_DECL void html_format::bytes(unsigned char const* data,
+                                      std::size_t size) {
+        bool const stray = line();
+        text() += "<pre>";
+        char buffer[hexdump_width];
+        for(std::size_t offset = 0; offset < size; offset += 16) {
+            if(offset > 0) {
+                text() += "\\n";
+            }
+            std::size_t const n = size - offset < 16 ? size - offset : 16;
+            escape(string_view(buffer, hexdump_line(buffer, offset,
+                                                    data + offset, n)));
+        }
+        text() += "</pre>";
+        if(stray) {
+            close_node();
+        }
+    }
+
+    DUMP_DECL void html_format::err(string_view text) {
+        write(text, "x");
+    }
+
+    DUMP_DECL void html_format::undefined() {
+        write("undefined", "u");
+    }
+
+}
+
+#endif //DUMP_IMPL_HTML_IPP
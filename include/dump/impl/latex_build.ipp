@@ -0,0 +1,167 @@
+#ifndef DUMP_IMPL_LATEX_BUILD_IPP
+#define DUMP_IMPL_LATEX_BUILD_IPP
+
+#include "dump/latex_build.hpp"
+#include "dump/traversal.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/version.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace dump {
+
+    namespace detail {
+
+        inline std::string shell_quoted(std::string const& text) {
+            std::string quoted = "'";
+            for(char c : text) {
+                if(c == '\'') {
+                    quoted += "'\\''";
+                } else {
+                    quoted += c;
+                }
+            }
+            return quoted + "'";
+        }
+
+        inline void build_latex(latex_build_result& result,
+                                latex_build_options const& options,
+                                boost::filesystem::path const& cache) {
+            namespace fs = boost::filesystem;
+            auto const start = std::chrono::steady_clock::now();
+            fs::path const source(result.source);
+            fs::path pdf = source;
+            pdf.replace_extension(".pdf");
+            result.pdf = pdf.string();
+            result.cached = false;
+            result.status = -1;
+
+            std::ifstream in(result.source, std::ios::binary);
+            std::ostringstream content;
+            if(in && content << in.rdbuf()) {
+                hash_format hasher;
+                hasher.value(options.command);
+                hasher.block(content.str());
+                fs::path const cached =
+                    cache / (to_string(hasher.digest()) + ".pdf");
+
+                boost::system::error_code error;
+                if(fs::exists(cached, error)) {
+#if BOOST_VERSION >= 107400
+                    fs::copy_file(cached, pdf,
+                                  fs::copy_options::overwrite_existing,
+                                  error);
+#else
+                    fs::copy_file(cached, pdf,
+                                  fs::copy_option::overwrite_if_exists,
+                                  error);
+#endif
+                    result.cached = !error;
+                }
+                if(result.cached) {
+                    result.status = 0;
+                } else {
+                    fs::path log = source;
+                    log.replace_extension(".build.log");
+                    fs::path directory = source.parent_path();
+                    if(directory.empty()) {
+                        directory = ".";
+                    }
+                    std::string const command =
+                        "cd " + shell_quoted(directory.string()) + " && "
+                        + options.command + " "
+                        + shell_quoted(source.filename().string())
+                        + " > " + shell_quoted(log.filename().string())
+                        + " 2>&1";
+                    int const status = std::system(command.c_str());
+                    result.status = status != 0 ? status
+                        : fs::exists(pdf, error) ? 0 : -1;
+                    if(result.status == 0) {
+                        // concurrent builds only see complete files
+                        fs::path const partial = cache
+                            / fs::unique_path("%%%%-%%%%-%%%%.partial");
+                        fs::copy_file(pdf, partial, error);
+                        if(!error) {
+                            fs::rename(partial, cached, error);
+                        }
+                    }
+                }
+            }
+            result.seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+
+    }
+
+    DUMP_DECL std::vector<latex_build_result>
+    latex_build(std::vector<std::string> const& sources,
+                latex_build_options const& options) {
+        namespace fs = boost::filesystem;
+        std::vector<latex_build_result> results(sources.size());
+        for(std::size_t i = 0; i < sources.size(); ++i) {
+            results[i].source = sources[i];
+        }
+
+        fs::path const cache = options.cache.empty()
+            ? fs::temp_directory_path() / "dump-latex-cache"
+            : fs::path(options.cache);
+        fs::create_directories(cache);
+
+        unsigned int jobs = options.jobs;
+        if(jobs == 0) {
+            jobs = std::max(1u, std::thread::hardware_concurrency());
+        }
+        std::atomic<std::size_t> next{0};
+        auto const work = [&]() {
+            for(std::size_t i = next++; i < results.size(); i = next++) {
+                detail::build_latex(results[i], options, cache);
+            }
+        };
+        std::vector<std::thread> workers;
+        for(std::size_t i = 1; i < jobs && i < results.size(); ++i) {
+            workers.emplace_back(work);
+        }
+        work();
+        for(std::thread& worker : workers) {
+            worker.join();
+        }
+        return results;
+    }
+
+    DUMP_DECL void write_latex_build_report(
+        std::ostream& out, std::vector<latex_build_result> const& results) {
+        std::vector<latex_build_result const*> sorted;
+        for(latex_build_result const& result : results) {
+            sorted.push_back(&result);
+        }
+        std::stable_sort(sorted.begin(), sorted.end(),
+                         [](latex_build_result const* a,
+                            latex_build_result const* b) {
+                             return a->seconds > b->seconds;
+                         });
+
+        std::ios_base::fmtflags const flags = out.flags();
+        std::streamsize const precision = out.precision();
+        out << "  seconds  result  source\n";
+        for(latex_build_result const* result : sorted) {
+            out << std::fixed << std::setprecision(3) << std::setw(9)
+                << result->seconds << "  "
+                << (result->status != 0 ? "failed"
+                    : result->cached ? "cached" : "built ")
+                << "  " << result->source << '\n';
+        }
+        out.flags(flags);
+        out.precision(precision);
+    }
+
+}
+
+#endif //DUMP_IMPL_LATEX_BUILD_IPP
@@ -0,0 +1,242 @@
+#ifndef DUMP_IMPL_LATEX_SUPPORT_IPP
+#define DUMP_IMPL_LATEX_SUPPORT_IPP
+
+#include "dump/latex_support.hpp"
+
+namespace dump {
+
+    DUMP_DECL std::string latex_support::get_header(bool layered) const {
+        return std::string(
+            "\\documentclass{minimal}\n"
+
+            "\\usepackage{luatex85}\n"
+
+            "\\usepackage[T1]{fontenc}\n"
+            "\\usepackage[utf8]{inputenc}\n"
+            "\\usepackage{textcomp}\n"
+
+            "\\usepackage{color}\n"
+            "\\usepackage{listings}\n"
+
+            "\\usepackage{tikz}\n")
+
+            + (layered ? "\\usetikzlibrary{graphdrawing,graphs,shapes}\n"
+                         "\\usegdlibrary{layered}\n"
+                       : "\\usetikzlibrary{shapes}\n")
+
+            + "\\usepackage{forest}\n"
+
+            "\\usepackage[active,tightpage]{preview}\n"
+
+            "\\PreviewEnvironment{lstlisting}\n"
+            "\\PreviewEnvironment{tikzpicture}\n"
+            "\\PreviewEnvironment{forest}\n"
+
+            "\\usepackage[numbered]{bookmark}\n"
+
+            "\\begin{document}\n";
+    }
+
+    DUMP_DECL std::string latex_support::get_footer() const {
+        return "\\end{document}\n";
+    }
+
+    DUMP_DECL void write_forest_preamble(std::ostream& out) {
+        out << "\\begin{forest}" << std::endl;
+        out << "  for tree={" << std::endl;
+        out << "    font=\\ttfamily," << std::endl;
+        out << "    grow'=0," << std::endl;
+        out << "    child anchor=west," << std::endl;
+        out << "    parent anchor=south," << std::endl;
+        out << "    anchor=west," << std::endl;
+        out << "    calign=first," << std::endl;
+        out << "    edge path={" << std::endl;
+        out << "      \\noexpand\\path [draw, \\forestoption{edge}]" << std::endl;
+        out << "      (!u.south west) +(7.5pt,0) |- node[fill,inner sep=1.25pt] {} (.child anchor)\\forestoption{edge label};" << std::endl;
+        out << "    }," << std::endl;
+        out << "    before typesetting nodes={" << std::endl;
+        out << "      if n=1" << std::endl;
+        out << "        {insert before={[,phantom]}}" << std::endl;
+        out << "        {}" << std::endl;
+        out << "    }," << std::endl;
+        out << "    fit=band," << std::endl;
+        out << "    before computing xy={l=15pt}," << std::endl;
+        out << "  }" << std::endl;
+    }
+
+    DUMP_DECL void write_forest_layout_preamble(std::ostream& out) {
+        out << "\\begin{tikzpicture}";
+        out << "[";
+        out << "every node/.style={";
+        out << "font=\\ttfamily, ";
+        out << "anchor=north west, ";
+        out << "align=left}";
+        out << "]";
+        out << std::endl;
+    }
+
+    DUMP_DECL void write_tikz_preamble(std::ostream& out, bool layered) {
+        out << "\\begin{tikzpicture}";
+        out << "[";
+        if(layered) {
+            out << "layered layout,";
+        }
+        out << "every edge/.style={";
+        out << "very thick, ";
+        out << "draw=blue!40!black!60, ";
+        out << "shorten >=1pt, shorten <=1pt}, ";
+        out << "every node/.style={";
+        out << "rectangle, ";
+        out << "text ragged, ";
+        out << "inner sep=2mm, ";
+        out << "rounded corners, ";
+        out << "shade, ";
+        out << "top color=white, ";
+        out << "bottom color=blue!50!black!20, ";
+        out << "draw=blue!40!black!60, ";
+        out << "very thick }";
+        out << "]";
+        out << std::endl;
+    }
+
+    namespace detail {
+
+        /*
+         * Whether `text` has the UTF-8 multiplication sign of repeated list
+         * items at `i`.
+         */
+        inline bool is_times(string_view text, std::size_t i) {
+            return i + 1 < text.size() && text[i] == '\xc3'
+                && text[i+1] == '\x97';
+        }
+
+        /*
+         * Whether `text` has the UTF-8 ellipsis of truncated values at `i`.
+         */
+        inline bool is_ellipsis(string_view text, std::size_t i) {
+            return i + 2 < text.size() && text[i] == '\xe2'
+                && text[i+1] == '\x80' && text[i+2] == '\xa6';
+        }
+
+    }
+
+    DUMP_DECL void write_forest_escaped(std::ostream& out, string_view text) {
+        std::size_t start = 0;
+        for(std::size_t i = 0; i < text.size(); ++i) {
+            char const* replacement = nullptr;
+            std::size_t length = 1;
+            switch(text[i]) {
+            case '_': replacement = "\\_"; break;
+            case '&': replacement = "\\&"; break;
+            case '#': replacement = "\\#"; break;
+            case '{': replacement = "\\{"; break;
+            case '}': replacement = "\\}"; break;
+            case ',': replacement = "{,}"; break;
+            case '[': replacement = "{[}"; break;
+            case ']': replacement = "{]}"; break;
+            case '=': replacement = "{=}"; break;
+            case '\xc3':
+                if(detail::is_times(text, i)) {
+                    replacement = "$\\times$";
+                    length = 2;
+                    break;
+                }
+                continue;
+            case '\xe2':
+                if(detail::is_ellipsis(text, i)) {
+                    replacement = "\\ldots{}";
+                    length = 3;
+                    break;
+                }
+                continue;
+            default: continue;
+            }
+            out.write(text.data() + start, i - start);
+            out << replacement;
+            start = i + length;
+            i += length - 1;
+        }
+        out.write(text.data() + start, text.size() - start);
+    }
+
+    DUMP_DECL void write_tikz_escaped(std::ostream& out, string_view text) {
+        std::size_t start = 0;
+        for(std::size_t i = 0; i < text.size(); ++i) {
+            char const* replacement = nullptr;
+            std::size_t length = 1;
+            bool const next_eq = i + 1 < text.size() && text[i+1] == '=';
+            switch(text[i]) {
+            case '_': replacement = "\\_"; break;
+            case '&': replacement = "\\&"; break;
+            case '#': replacement = "\\#"; break;
+            case '{': replacement = "\\{"; break;
+            case '}': replacement = "\\}"; break;
+            case '-':
+                if(i + 1 < text.size() && text[i+1] == '>') {
+                    replacement = "$\\rightarrow$";
+                    length = 2;
+                }
+                break;
+            case '<':
+                replacement = next_eq ? "$\\leq$" : "$<$";
+                length = next_eq ? 2 : 1;
+                break;
+            case '>':
+                replacement = next_eq ? "$\\geq$" : "$>$";
+                length = next_eq ? 2 : 1;
+                break;
+            case '\xc3':
+                if(detail::is_times(text, i)) {
+                    replacement = "$\\times$";
+                    length = 2;
+                }
+                break;
+            case '\xe2':
+                if(detail::is_ellipsis(text, i)) {
+                    replacement = "\\ldots{}";
+                    length = 3;
+                }
+                break;
+            }
+            if(replacement) {
+                out.write(text.data() + start, i - start);
+                out << replacement;
+                start = i + length;
+                i += length - 1;
+            }
+        }
+        out.write(text.data() + start, text.size() - start);
+    }
+
+    DUMP_DECL void write_latex_hexdump(std::ostream& out,
+                                       unsigned char const* data,
+                                       std::size_t size) {
+        char line[hexdump_width];
+        for(std::size_t offset = 0; offset < size; offset += 16) {
+            if(offset > 0) {
+                out << "\\\\\n";
+            }
+            std::size_t const n = size - offset < 16 ? size - offset : 16;
+            std::size_t const length =
+                hexdump_line(line, offset, data + offset, n);
+            for(std::size_t i = 0; i < length; ++i) {
+                switch(line[i]) {
+                case ' ':
+                    line[i] = '~';
+                    break;
+                case '\\': case '{': case '}': case '$': case '&':
+                case '#': case '^': case '_': case '~': case '%':
+                case '[': case ']': case ',': case '=':
+                    line[i] = '.';
+                    break;
+                }
+            }
+            out << "\\texttt{";
+            out.write(line, length);
+            out << '}';
+        }
+    }
+
+}
+
+#endif //DUMP_IMPL_LATEX_SUPPORT_IPP
@@ -0,0 +1,551 @@
+#ifndef DUMP_IMPL_LAYOUT_IPP
+#define DUMP_IMPL_LAYOUT_IPP
+
+#include "dump/layout.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace dump {
+
+    namespace detail {
+
+        /**
+         * Adjacency lists of `size` nodes in one array, the neighbours of
+         * node `i` are `items[first[i]]` up to `items[first[i + 1]]`.
+         */
+        struct adjacency {
+            std::vector<std::size_t> first;
+            std::vector<std::size_t> items;
+
+            /**
+             * `pairs` of a node and a neighbour, in any order
+             */
+            adjacency(std::size_t size,
+                      std::vector<std::pair<std::size_t, std::size_t>> const&
+                          pairs)
+                : first(size + 1, 0), items(pairs.size()) {
+                for(auto const& pair : pairs) {
+                    ++first[pair.first + 1];
+                }
+                for(std::size_t i = 0; i < size; ++i) {
+                    first[i + 1] += first[i];
+                }
+                std::vector<std::size_t> next(first.begin(), first.end() - 1);
+                for(auto const& pair : pairs) {
+                    items[next[pair.first]++] = pair.second;
+                }
+            }
+
+            std::size_t const* begin(std::size_t node) const {
+                return items.data() + first[node];
+            }
+
+            std::size_t const* end(std::size_t node) const {
+                return items.data() + first[node + 1];
+            }
+        };
+
+        /**
+         * Move the centers `x` of a layer as close as possible to their
+         * `targets`, in the least squares sense with the given `weights`,
+         * while consecutive centers stay at least `gaps` apart.
+         *
+         * Subtracting the accumulated gaps leaves a monotone regression,
+         * which pooling adjacent violators solves in linear time.
+         */
+        inline void place_layer(std::vector<double>& x,
+                                std::vector<double> const& targets,
+                                std::vector<double> const& weights,
+                                std::vector<double> const& gaps) {
+            struct block {
+                double sum;
+                double weight;
+                std::size_t size;
+            };
+            std::vector<block> blocks;
+            double offset = 0;
+            for(std::size_t i = 0; i < x.size(); ++i) {
+                if(i > 0) {
+                    offset += gaps[i - 1];
+                }
+                blocks.push_back(block{(targets[i] - offset) * weights[i],
+                                       weights[i], 1});
+                while(blocks.size() > 1) {
+                    block& last = blocks.back();
+                    block& previous = blocks[blocks.size() - 2];
+                    if(previous.sum / previous.weight
+                       <= last.sum / last.weight) {
+                        break;
+                    }
+                    previous.sum += last.sum;
+                    previous.weight += last.weight;
+                    previous.size += last.size;
+                    blocks.pop_back();
+                }
+            }
+            std::size_t i = 0;
+            offset = 0;
+            for(block const& b : blocks) {
+                double const position = b.sum / b.weight;
+                for(std::size_t j = 0; j < b.size; ++j, ++i) {
+                    if(i > 0) {
+                        offset += gaps[i - 1];
+                    }
+                    x[i] = position + offset;
+                }
+            }
+        }
+
+    }
+
+    DUMP_DECL void layered_layout(std::vector<layout_node>& nodes,
+                                  std::vector<layout_edge>& edges,
+                                  layout_options const& options) {
+        typedef std::pair<std::size_t, std::size_t> pair;
+        std::size_t const n = nodes.size();
+        if(n == 0) {
+            return;
+        }
+
+        // cycle removal: reverse the edges to a node on the stack of a
+        // depth-first search, starting from the first nodes
+        std::vector<pair> pairs;
+        for(std::size_t e = 0; e < edges.size(); ++e) {
+            if(edges[e].from != edges[e].to) {
+                pairs.emplace_back(edges[e].from, e);
+            }
+        }
+        detail::adjacency const out(n, pairs);
+        std::vector<bool> reversed(edges.size(), false);
+        {
+            enum { unvisited, active, done };
+            std::vector<char> state(n, unvisited);
+            std::vector<pair> stack;
+            for(std::size_t root = 0; root < n; ++root) {
+                if(state[root] != unvisited) {
+                    continue;
+                }
+                state[root] = active;
+                stack.emplace_back(root, out.first[root]);
+                while(!stack.empty()) {
+                    std::size_t const node = stack.back().first;
+                    if(stack.back().second == out.first[node + 1]) {
+                        state[node] = done;
+                        stack.pop_back();
+                        continue;
+                    }
+                    std::size_t const e = out.items[stack.back().second++];
+                    std::size_t const to = edges[e].to;
+                    if(state[to] == active) {
+                        reversed[e] = true;
+                    } else if(state[to] == unvisited) {
+                        state[to] = active;
+                        stack.emplace_back(to, out.first[to]);
+                    }
+                }
+            }
+        }
+        auto const upper = [&](std::size_t e) {
+            return reversed[e] ? edges[e].to : edges[e].from;
+        };
+        auto const lower = [&](std::size_t e) {
+            return reversed[e] ? edges[e].from : edges[e].to;
+        };
+
+        // layer assignment: longest path from the sources, in topological
+        // order
+        std::vector<std::size_t> layer(n, 0);
+        {
+            pairs.clear();
+            std::vector<std::size_t> incoming(n, 0);
+            for(std::size_t e = 0; e < edges.size(); ++e) {
+                if(edges[e].from != edges[e].to) {
+                    pairs.emplace_back(upper(e), lower(e));
+                    ++incoming[lower(e)];
+                }
+            }
+            detail::adjacency const down(n, pairs);
+            std::vector<std::size_t> ready;
+            for(std::size_t i = n; i-- > 0;) {
+                if(incoming[i] == 0) {
+                    ready.push_back(i);
+                }
+            }
+            while(!ready.empty()) {
+                std::size_t const node = ready.back();
+                ready.pop_back();
+                for(auto i = down.begin(node); i != down.end(node); ++i) {
+                    layer[*i] = std::max(layer[*i], layer[node] + 1);
+                    if(--incoming[*i] == 0) {
+                        ready.push_back(*i);
+                    }
+                }
+            }
+        }
+
+        // a virtual node on every layer an edge passes, after the nodes
+        std::vector<std::size_t> bends(edges.size() + 1, 0);
+        for(std::size_t e = 0; e < edges.size(); ++e) {
+            std::size_t const span = edges[e].from == edges[e].to ? 0
+                : layer[lower(e)] - layer[upper(e)];
+            bends[e + 1] = bends[e] + (span > 1 ? span - 1 : 0);
+        }
+        std::size_t const size = n + bends.back();
+        layer.resize(size);
+        pairs.clear();
+        for(std::size_t e = 0; e < edges.size(); ++e) {
+            if(edges[e].from == edges[e].to) {
+                continue;
+            }
+            std::size_t previous = upper(e);
+            for(std::size_t b = n + bends[e]; b < n + bends[e + 1]; ++b) {
+                layer[b] = layer[previous] + 1;
+                pairs.emplace_back(previous, b);
+                previous = b;
+            }
+            pairs.emplace_back(previous, lower(e));
+        }
+        detail::adjacency const down(size, pairs);
+        for(pair& p : pairs) {
+            std::swap(p.first, p.second);
+        }
+        detail::adjacency const up(size, pairs);
+
+        std::size_t const layer_count =
+            *std::max_element(layer.begin(), layer.end()) + 1;
+        std::vector<std::vector<std::size_t>> layers(layer_count);
+        std::vector<std::size_t> position(size);
+        for(std::size_t v = 0; v < size; ++v) {
+            position[v] = layers[layer[v]].size();
+            layers[layer[v]].push_back(v);
+        }
+
+        // crossing reduction: sort the layers by the barycenters of the
+        // positions of their neighbours on the previous one
+        std::vector<double> key(size);
+        auto const order = [&](std::size_t l, detail::adjacency const& adj) {
+            std::vector<std::size_t>& members = layers[l];
+            for(std::size_t v : members) {
+                double sum = 0;
+                for(auto i = adj.begin(v); i != adj.end(v); ++i) {
+                    sum += position[*i];
+                }
+                key[v] = adj.begin(v) == adj.end(v) ? position[v]
+                    : sum / (adj.end(v) - adj.begin(v));
+            }
+            std::stable_sort(members.begin(), members.end(),
+                             [&key](std::size_t a, std::size_t b) {
+                                 return key[a] < key[b];
+                             });
+            for(std::size_t i = 0; i < members.size(); ++i) {
+                position[members[i]] = i;
+            }
+        };
+        for(std::size_t s = 0; s < options.sweeps; ++s) {
+            for(std::size_t l = 1; l < layer_count; ++l) {
+                order(l, up);
+            }
+            for(std::size_t l = layer_count - 1; l-- > 0;) {
+                order(l, down);
+            }
+        }
+
+        // coordinate assignment: the centers closest to the barycenters of
+        // the neighbours, alternately above and below
+        auto const width = [&](std::size_t v) {
+            return v < n ? nodes[v].width : 0.0;
+        };
+        std::vector<double> center(size);
+        std::vector<double> x, targets, weights, gaps;
+        auto const spread = [&](std::size_t l) {
+            std::vector<std::size_t> const& members = layers[l];
+            gaps.clear();
+            for(std::size_t i = 1; i < members.size(); ++i) {
+                std::size_t const a = members[i - 1];
+                std::size_t const b = members[i];
+                // bends of different edges may be closer
+                double const spacing = a < n || b < n
+                    ? options.node_spacing : options.node_spacing / 2;
+                gaps.push_back((width(a) + width(b)) / 2 + spacing);
+            }
+        };
+        for(std::size_t l = 0; l < layer_count; ++l) {
+            spread(l);
+            double offset = 0;
+            for(std::size_t i = 0; i < layers[l].size(); ++i) {
+                if(i > 0) {
+                    offset += gaps[i - 1];
+                }
+                center[layers[l][i]] = offset;
+            }
+        }
+        auto const place = [&](std::size_t l, detail::adjacency const& adj) {
+            std::vector<std::size_t> const& members = layers[l];
+            x.resize(members.size());
+            targets.resize(members.size());
+            weights.resize(members.size());
+            for(std::size_t i = 0; i < members.size(); ++i) {
+                std::size_t const v = members[i];
+                double sum = 0;
+                for(auto j = adj.begin(v); j != adj.end(v); ++j) {
+                    sum += center[*j];
+                }
+                std::size_t const count = adj.end(v) - adj.begin(v);
+                targets[i] = count > 0 ? sum / count : center[v];
+                weights[i] = count > 0 ? count : 1;
+            }
+            spread(l);
+            detail::place_layer(x, targets, weights, gaps);
+            for(std::size_t i = 0; i < members.size(); ++i) {
+                center[members[i]] = x[i];
+            }
+        };
+        for(std::size_t s = 0; s < options.sweeps; ++s) {
+            for(std::size_t l = 1; l < layer_count; ++l) {
+                place(l, up);
+            }
+            for(std::size_t l = layer_count - 1; l-- > 0;) {
+                place(l, down);
+            }
+        }
+
+        double left = center[0] - width(0) / 2;
+        for(std::size_t v = 1; v < size; ++v) {
+            left = std::min(left, center[v] - width(v) / 2);
+        }
+        std::vector<double> top(layer_count, 0);
+        std::vector<double> height(layer_count, 0);
+        for(std::size_t v = 0; v < n; ++v) {
+            height[layer[v]] = std::max(height[layer[v]], nodes[v].height);
+        }
+        for(std::size_t l = 1; l < layer_count; ++l) {
+            top[l] = top[l - 1] + height[l - 1] + options.layer_spacing;
+        }
+        for(std::size_t v = 0; v < n; ++v) {
+            nodes[v].x = center[v] - left - nodes[v].width / 2;
+            nodes[v].y = top[layer[v]];
+        }
+
+        for(std::size_t e = 0; e < edges.size(); ++e) {
+            layout_edge& edge = edges[e];
+            edge.points.clear();
+            if(edge.from == edge.to) {
+                // loop on the right side
+                layout_node const& node = nodes[edge.from];
+                double const right = node.x + node.width;
+                double const y1 = node.y + node.height / 3;
+                double const y2 = node.y + node.height * 2 / 3;
+                double const out = options.node_spacing / 2;
+                edge.points.push_back(layout_point{right, y1});
+                edge.points.push_back(layout_point{right + out, y1});
+                edge.points.push_back(layout_point{right + out, y2});
+                edge.points.push_back(layout_point{right, y2});
+                continue;
+            }
+            layout_node const& from = nodes[upper(e)];
+            layout_node const& to = nodes[lower(e)];
+            edge.points.push_back(layout_point{from.x + from.width / 2,
+                                               from.y + from.height});
+            // straight through the layers of the bends
+            for(std::size_t b = n + bends[e]; b < n + bends[e + 1]; ++b) {
+                double const x = center[b] - left;
+                edge.points.push_back(layout_point{x, top[layer[b]]});
+                edge.points.push_back(
+                    layout_point{x, top[layer[b]] + height[layer[b]]});
+            }
+            edge.points.push_back(layout_point{to.x + to.width / 2, to.y});
+            if(reversed[e]) {
+                std::reverse(edge.points.begin(), edge.points.end());
+            }
+        }
+    }
+
+
+    DUMP_DECL void tree_layout(std::vector<layout_node>& nodes,
+                               std::vector<std::size_t> const& parents,
+                               layout_options const& options) {
+        typedef std::pair<std::size_t, std::size_t> pair;
+        std::size_t const n = nodes.size();
+        if(n == 0) {
+            return;
+        }
+
+        // the roots are the children of a virtual node after the others
+        std::size_t const root = n;
+        std::vector<pair> pairs;
+        pairs.reserve(n);
+        for(std::size_t v = 0; v < n; ++v) {
+            pairs.emplace_back(parents[v] == no_parent ? root : parents[v],
+                               v);
+        }
+        detail::adjacency const children(n + 1, pairs);
+        std::vector<std::size_t> parent(n + 1, root);
+        std::vector<std::size_t> number(n + 1, 0);
+        for(std::size_t p = 0; p <= n; ++p) {
+            std::size_t k = 0;
+            for(auto i = children.begin(p); i != children.end(p); ++i) {
+                parent[*i] = p;
+                number[*i] = k++;
+            }
+        }
+
+        auto const width = [&](std::size_t v) {
+            return v < n ? nodes[v].width : 0.0;
+        };
+        auto const separation = [&](std::size_t a, std::size_t b) {
+            return (width(a) + width(b)) / 2 + options.node_spacing;
+        };
+        auto const left_sibling = [&](std::size_t v) {
+            return children.begin(parent[v])[number[v] - 1];
+        };
+        auto const leaf = [&](std::size_t v) {
+            return children.begin(v) == children.end(v);
+        };
+
+        // contours of the subtrees are followed along the outermost
+        // children and, below the leaves, along threads
+        std::size_t const none = no_parent;
+        std::vector<std::size_t> thread(n + 1, none);
+        auto const next_left = [&](std::size_t v) {
+            return leaf(v) ? thread[v] : *children.begin(v);
+        };
+        auto const next_right = [&](std::size_t v) {
+            return leaf(v) ? thread[v] : children.end(v)[-1];
+        };
+
+        // prelim is relative to the parent until the modifiers of the
+        // ancestors are added. Shifts of subtrees are spread over the
+        // subtrees in between by `shift` and `change`.
+        std::vector<double> prelim(n + 1, 0);
+        std::vector<double> mod(n + 1, 0);
+        std::vector<double> shift(n + 1, 0);
+        std::vector<double> change(n + 1, 0);
+        std::vector<double> middle(n + 1, 0);
+        std::vector<std::size_t> ancestor(n + 1);
+        for(std::size_t v = 0; v <= n; ++v) {
+            ancestor[v] = v;
+        }
+
+        auto const move_subtree = [&](std::size_t left, std::size_t right,
+                                      double distance) {
+            double const subtrees = number[right] - number[left];
+            change[right] -= distance / subtrees;
+            shift[right] += distance;
+            change[left] += distance / subtrees;
+            prelim[right] += distance;
+            mod[right] += distance;
+        };
+
+        // move the subtree of `v` right of the subtrees of its left
+        // siblings
+        auto const apportion = [&](std::size_t v,
+                                   std::size_t& default_ancestor) {
+            std::size_t inner_right = v;
+            std::size_t outer_right = v;
+            std::size_t inner_left = left_sibling(v);
+            std::size_t outer_left = *children.begin(parent[v]);
+            double inner_right_mod = mod[inner_right];
+            double outer_right_mod = mod[outer_right];
+            double inner_left_mod = mod[inner_left];
+            double outer_left_mod = mod[outer_left];
+            while(next_right(inner_left) != none
+                  && next_left(inner_right) != none) {
+                inner_left = next_right(inner_left);
+                inner_right = next_left(inner_right);
+                outer_left = next_left(outer_left);
+                outer_right = next_right(outer_right);
+                ancestor[outer_right] = v;
+                double const distance = prelim[inner_left] + inner_left_mod
+                    - prelim[inner_right] - inner_right_mod
+                    + separation(inner_left, inner_right);
+                if(distance > 0) {
+                    std::size_t const a = ancestor[inner_left];
+                    move_subtree(parent[a] == parent[v]
+                                     ? a : default_ancestor,
+                                 v, distance);
+                    inner_right_mod += distance;
+                    outer_right_mod += distance;
+                }
+                inner_left_mod += mod[inner_left];
+                inner_right_mod += mod[inner_right];
+                outer_left_mod += mod[outer_left];
+                outer_right_mod += mod[outer_right];
+            }
+            if(next_right(inner_left) != none
+               && next_right(outer_right) == none) {
+                thread[outer_right] = next_right(inner_left);
+                mod[outer_right] += inner_left_mod - outer_right_mod;
+            }
+            if(next_left(inner_right) != none
+               && next_left(outer_left) == none) {
+                thread[outer_left] = next_left(inner_right);
+                mod[outer_left] += inner_right_mod - outer_left_mod;
+                default_ancestor = v;
+            }
+        };
+
+        // children come after their parents, so going backwards visits
+        // the subtrees bottom up
+        for(std::size_t k = 0; k <= n; ++k) {
+            std::size_t const v = k < n ? n - 1 - k : root;
+            if(leaf(v)) {
+                continue;
+            }
+            std::size_t default_ancestor = *children.begin(v);
+            for(auto i = children.begin(v); i != children.end(v); ++i) {
+                std::size_t const w = *i;
+                if(number[w] > 0) {
+                    std::size_t const u = left_sibling(w);
+                    prelim[w] = prelim[u] + separation(u, w);
+                    if(!leaf(w)) {
+                        mod[w] = prelim[w] - middle[w];
+                    }
+                    apportion(w, default_ancestor);
+                } else {
+                    prelim[w] = middle[w];
+                }
+            }
+            double distance = 0;
+            double step = 0;
+            for(auto i = children.end(v); i != children.begin(v);) {
+                std::size_t const w = *--i;
+                prelim[w] += distance;
+                mod[w] += distance;
+                step += change[w];
+                distance += shift[w] + step;
+            }
+            middle[v] = (prelim[*children.begin(v)]
+                         + prelim[children.end(v)[-1]]) / 2;
+        }
+
+        // absolute positions and layers top down
+        std::vector<double> sum(n + 1, 0);
+        std::vector<std::size_t> depth(n + 1, 0);
+        std::vector<double> height;
+        double left = 0;
+        for(std::size_t v = 0; v < n; ++v) {
+            std::size_t const p = parent[v];
+            double const center = prelim[v] + sum[p];
+            sum[v] = sum[p] + mod[v];
+            depth[v] = p == root ? 0 : depth[p] + 1;
+            if(depth[v] == height.size()) {
+                height.push_back(0);
+            }
+            height[depth[v]] = std::max(height[depth[v]], nodes[v].height);
+            nodes[v].x = center - nodes[v].width / 2;
+            left = v == 0 ? nodes[v].x : std::min(left, nodes[v].x);
+        }
+        std::vector<double> top(height.size(), 0);
+        for(std::size_t d = 1; d < height.size(); ++d) {
+            top[d] = top[d - 1] + height[d - 1] + options.layer_spacing;
+        }
+        for(std::size_t v = 0; v < n; ++v) {
+            nodes[v].x -= left;
+            nodes[v].y = top[depth[v]];
+        }
+    }
+
+}
+
+#endif //DUMP_IMPL_LAYOUT_IPP
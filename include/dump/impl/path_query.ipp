@@ -0,0 +1,212 @@
+#ifndef DUMP_IMPL_PATH_QUERY_IPP
+#define DUMP_IMPL_PATH_QUERY_IPP
+
+#include "dump/path_query.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+
+namespace dump {
+
+    DUMP_DECL path_query::path_query(string_view pattern) {
+        std::size_t start = 0;
+        while(start <= pattern.size()) {
+            std::size_t end = pattern.find('/', start);
+            if(end == string_view::npos) {
+                end = pattern.size();
+            }
+            string_view text = pattern.substr(start, end - start);
+            start = end + 1;
+            if(text.empty()) {
+                continue;
+            }
+
+            segment s{segment::label, std::string(), -1};
+            if(text.back() == ']') {
+                std::size_t const open = text.rfind('[');
+                if(open == string_view::npos || open + 2 >= text.size()) {
+                    throw std::invalid_argument(
+                        "path_query: malformed index in '"
+                        + std::string(text.data(), text.size()) + "'");
+                }
+                std::string const digits(text.data() + open + 1,
+                                         text.size() - open - 2);
+                char* digits_end = nullptr;
+                s.index = std::strtol(digits.c_str(), &digits_end, 10);
+                if(*digits_end != '\0' || s.index < 0) {
+                    throw std::invalid_argument(
+                        "path_query: malformed index in '"
+                        + std::string(text.data(), text.size()) + "'");
+                }
+                text = text.substr(0, open);
+            }
+            if(text == "**") {
+                if(s.index >= 0) {
+                    throw std::invalid_argument(
+                        "path_query: '**' can not have an index");
+                }
+                s.kind = segment::any_path;
+            } else if(text == "*") {
+                s.kind = segment::any;
+            } else {
+                s.text.assign(text.data(), text.size());
+            }
+            segments.push_back(s);
+        }
+        if(segments.size() >= 64) {
+            throw std::invalid_argument(
+                "path_query: more than 63 segments");
+        }
+    }
+
+    DUMP_DECL std::uint64_t path_query::closure(std::uint64_t state) const {
+        for(std::size_t i = 0; i < segments.size(); ++i) {
+            if((state >> i & 1) && segments[i].kind == segment::any_path) {
+                state |= std::uint64_t(1) << (i + 1);
+            }
+        }
+        return state;
+    }
+
+    DUMP_DECL std::uint64_t path_query::start() const {
+        return closure(1);
+    }
+
+    DUMP_DECL std::uint64_t path_query::step(std::uint64_t state,
+                                             string_view label,
+                                             long index) const {
+        std::uint64_t next = 0;
+        for(std::size_t i = 0; i < segments.size(); ++i) {
+            if(!(state >> i & 1)) {
+                continue;
+            }
+            segment const& s = segments[i];
+            if(s.kind == segment::any_path) {
+                next |= std::uint64_t(1) << i;
+            } else if((s.kind == segment::any || label == s.text)
+                      && (s.index < 0 || s.index == index)) {
+                next |= std::uint64_t(1) << (i + 1);
+            }
+        }
+        return closure(next);
+    }
+
+    DUMP_DECL path_selection::path_selection(path_query const& query)
+        : query(query), probing(true), cursor(0) {
+        std::uint64_t const state = query.start();
+        frames.push_back(frame{state, 0, none, none,
+                               (state & query.accepted()) != 0});
+    }
+
+    DUMP_DECL void path_selection::matched(frame& parent,
+                                           std::size_t record) {
+        records[record].match = true;
+        if(parent.last_match != none) {
+            records[parent.last_match].last = false;
+        }
+        parent.last_match = record;
+    }
+
+    DUMP_DECL bool path_selection::enter(string_view label, bool item,
+                                         bool inlined, bool& last_child) {
+        frame& top = frames.back();
+        if(top.full) {
+            frames.push_back(frame{0, 0, none, none, true});
+            return true;
+        }
+        long const index = item ? static_cast<long>(top.items++) : -1;
+        std::uint64_t const state = query.step(top.state, label, index);
+        if(state == 0) {
+            return false;
+        }
+        bool const full = (state & query.accepted()) != 0;
+
+        if(probing) {
+            std::size_t const r = records.size();
+            records.push_back(record{r + 1, false, true});
+            if(full) {
+                // everything below is dumped, no need to look further
+                matched(top, r);
+                return false;
+            }
+            frames.push_back(frame{state, 0, r, none, false});
+            return true;
+        }
+
+        record const& current = records[cursor];
+        if(!current.match) {
+            cursor = current.end;
+            return false;
+        }
+        last_child = current.last;
+        frames.push_back(frame{state, 0, cursor, none, full});
+        ++cursor;
+        return true;
+    }
+
+    DUMP_DECL void path_selection::leave() {
+        frame const done = frames.back();
+        frames.pop_back();
+        if(done.record == none) {
+            return;
+        }
+        if(probing) {
+            records[done.record].end = records.size();
+            if(done.last_match != none) {
+                matched(frames.back(), done.record);
+            }
+        } else {
+            cursor = records[done.record].end;
+        }
+    }
+
+    DUMP_DECL void path_selection::select_items(std::size_t& first,
+                                                std::size_t& last) {
+        frame& top = frames.back();
+        if(top.full) {
+            return;
+        }
+        std::size_t low = none;
+        std::size_t high = 0;
+        for(std::size_t i = 0; i < query.segments.size(); ++i) {
+            if(!(top.state >> i & 1)) {
+                continue;
+            }
+            path_query::segment const& s = query.segments[i];
+            if(s.kind == path_query::segment::any_path
+               || (s.index < 0 && (s.kind == path_query::segment::any
+                                   || s.text == "item"))) {
+                // any item may match
+                return;
+            }
+            if(s.index >= 0 && (s.kind == path_query::segment::any
+                                || s.text == "item")) {
+                std::size_t const index = static_cast<std::size_t>(s.index);
+                low = index < low ? index : low;
+                high = index + 1 > high ? index + 1 : high;
+            }
+        }
+        if(low == none) {
+            // no item can match
+            first = last;
+            return;
+        }
+        first = low > first ? (low < last ? low : last) : first;
+        last = high < last ? high : last;
+        if(first > last) {
+            first = last;
+        }
+        top.items += first;
+    }
+
+    DUMP_DECL void path_selection::replay() {
+        probing = false;
+        cursor = 0;
+        frames.resize(1);
+        frames.back().items = 0;
+        frames.back().last_match = none;
+    }
+
+}
+
+#endif //DUMP_IMPL_PATH_QUERY_IPP
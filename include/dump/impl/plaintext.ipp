@@ -0,0 +1,165 @@
+#ifndef DUMP_IMPL_PLAINTEXT_IPP
+#define DUMP_IMPL_PLAINTEXT_IPP
+
+#include "dump/plaintext.hpp"
+
+namespace dump {
+
+    DUMP_DECL plaintext_format::plaintext_format(std::ostream& out)
+        : out(out) {
+        frames.push_back(frame{"", false});
+    }
+
+    DUMP_DECL void plaintext_format::start() {
+        format_policy::start();
+        prefix.clear();
+        captures.clear();
+        frames.clear();
+        frames.push_back(frame{"", false});
+    }
+
+    DUMP_DECL void plaintext_format::push(attribute const& attr) {
+        frames.push_back(frame{attr.label, attr.inlined});
+        if(!attr.inlined) {
+            prefix += (attr.last_child ? "  " : "| ");
+        }
+    }
+
+    DUMP_DECL void plaintext_format::enter(attribute const& attr) {
+        if(!attr.inlined) {
+            out << '\n';
+            out << prefix;
+            out << (attr.last_child ? '`' : '|');
+            out << "- ";
+        } else {
+            out << ' ';
+        }
+        if(attr.label.length() > 0) {
+            out << attr.label << ' ';
+        }
+        push(attr);
+    }
+
+    DUMP_DECL void plaintext_format::leave(attribute const& attr) {
+        if(!attr.inlined) {
+            prefix.resize(prefix.size() - 2);
+        }
+        frames.pop_back();
+    }
+
+    DUMP_DECL void plaintext_format::node(object_ref node,
+                                          string_view text) {
+        out << text;
+    }
+
+    DUMP_DECL void plaintext_format::type(std::type_info const& info) {
+        // alternatively use info.name() which is not required to be
+        // human readable
+        out << pretty_name(info);
+    }
+
+    DUMP_DECL void plaintext_format::addr(void const* address) {
+        out << address;
+    }
+
+    DUMP_DECL void plaintext_format::type_addr(std::type_info const& info,
+                                               void const* address) {
+        out << ' ';
+        type(info);
+        out << ' ';
+        addr(address);
+    }
+
+    DUMP_DECL void plaintext_format::enumeration(string_view text) {
+        out << text;
+    }
+
+    DUMP_DECL void plaintext_format::value(string_view text) {
+        out << "'" << text << "'";
+    }
+
+    DUMP_DECL void plaintext_format::string(string_view text) {
+        frame const& current = frames.back();
+        // We expect inlined string attributes to be one liners
+        if(current.inlined) {
+            value(text);
+        } else {
+            write_lines(out, text, [&](std::ostream& out) {
+                // Prefix content
+                out << '\n' << prefix;
+                // Label indentation +2 for spaces around
+                write_spaces(out, current.label.size()+2);
+            });
+        }
+    }
+
+    DUMP_DECL void plaintext_format::block(string_view text) {
+        out << '\n' << prefix << "`- ";
+        write_lines(out, text, [this](std::ostream& out) {
+            out << '\n' << prefix << "  ";
+        });
+    }
+
+    DUMP_DECL void plaintext_format::bytes(unsigned char const* data,
+                                           std::size_t size) {
+        out << '\n' << prefix << "`- ";
+        write_hexdump(out, data, size, [this](std::ostream& out) {
+            out << '\n' << prefix << "  ";
+        });
+    }
+
+    DUMP_DECL void plaintext_format::err(string_view text) {
+        out << text;
+    }
+
+    DUMP_DECL void plaintext_format::undefined() {
+        out << "undefined";
+    }
+
+    DUMP_DECL bool plaintext_format::cache_context(
+        std::string& context) const {
+        // multi-line strings are indented by the label
+        frame const& current = frames.back();
+        context.assign(current.label.data(), current.label.size());
+        context += current.inlined ? '\1' : '\0';
+        return true;
+    }
+
+    DUMP_DECL void plaintext_format::capture(std::streambuf* buffer) {
+        captures.push_back(captured{out.rdbuf(buffer), std::move(prefix)});
+        prefix.clear();
+    }
+
+    DUMP_DECL void plaintext_format::release() {
+        out.rdbuf(captures.back().buffer);
+        prefix = std::move(captures.back().prefix);
+        captures.pop_back();
+    }
+
+    DUMP_DECL void plaintext_format::splice(string_view text) {
+        write_spliced(text, false);
+    }
+
+    DUMP_DECL void plaintext_format::write_spliced(string_view text,
+                                                   bool escapes) {
+        std::size_t start = 0;
+        for(std::size_t i = 0; i < text.size(); ++i) {
+            if(text[i] != '\n') {
+                continue;
+            }
+            std::size_t line = i + 1;
+            while(escapes && line < text.size() && text[line] == '\x1B') {
+                std::size_t const end = text.find('m', line);
+                line = end == string_view::npos ? text.size() : end + 1;
+            }
+            out.write(text.data() + start, line - start);
+            out << prefix;
+            start = line;
+            i = line - 1;
+        }
+        out.write(text.data() + start, text.size() - start);
+    }
+
+}
+
+#endif //DUMP_IMPL_PLAINTEXT_IPP
@@ -0,0 +1,81 @@
+#ifndef DUMP_IMPL_RENDER_CACHE_IPP
+#define DUMP_IMPL_RENDER_CACHE_IPP
+
+#include "dump/render_cache.hpp"
+
+#include <functional>
+
+namespace dump {
+
+    DUMP_DECL bool render_cache::key::operator==(key const& other) const {
+        return object == other.object && *format == *other.format
+            && *dumper == *other.dumper && version == other.version
+            && context == other.context
+            && collapse_runs == other.collapse_runs
+            && max_value_chars == other.max_value_chars
+            && max_value_lines == other.max_value_lines;
+    }
+
+    DUMP_DECL std::size_t
+    render_cache::key_hash::operator()(key const& k) const {
+        std::size_t h = std::hash<void const*>()(k.object.address);
+        auto const combine = [&h](std::size_t value) {
+            h ^= value + 0x9e3779b9 + (h << 6) + (h >> 2);
+        };
+        combine(k.object.type->hash_code());
+        combine(k.format->hash_code());
+        combine(k.dumper->hash_code());
+        combine(std::hash<std::uint64_t>()(k.version));
+        combine(std::hash<std::string>()(k.context));
+        combine(k.collapse_runs);
+        combine(k.max_value_chars);
+        combine(k.max_value_lines);
+        return h;
+    }
+
+    DUMP_DECL render_cache::render_cache(std::size_t capacity)
+        : limit(capacity) {}
+
+    DUMP_DECL std::string const* render_cache::find(key const& k) {
+        auto const found = index.find(k);
+        if(found == index.end()) {
+            ++misses;
+            return nullptr;
+        }
+        ++hits;
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->second;
+    }
+
+    DUMP_DECL void render_cache::insert(key k, std::string text) {
+        auto const found = index.find(k);
+        if(found != index.end()) {
+            used -= cost(*found->second);
+            entries.erase(found->second);
+            index.erase(found);
+        }
+        entries.emplace_front(std::move(k), std::move(text));
+        std::size_t const size = cost(entries.front());
+        if(size > limit) {
+            entries.pop_front();
+            return;
+        }
+        index.emplace(entries.front().first, entries.begin());
+        used += size;
+        while(used > limit) {
+            entry const& oldest = entries.back();
+            used -= cost(oldest);
+            index.erase(oldest.first);
+            entries.pop_back();
+        }
+    }
+
+    DUMP_DECL void render_cache::clear() {
+        index.clear();
+        entries.clear();
+        used = 0;
+    }
+
+}
+
+#endif //DUMP_IMPL_RENDER_CACHE_IPP
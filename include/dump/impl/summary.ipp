@@ -0,0 +1,281 @@
+#ifndef DUMP_IMPL_SUMMARY_IPP
+#define DUMP_IMPL_SUMMARY_IPP
+
+#include "dump/summary.hpp"
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#endif
+
+namespace dump {
+
+    namespace detail {
+
+        /*
+         * Scalar reduction of `[first, last)` into `stats`, also used for
+         * the remainder of the vectorized loops.
+         */
+        template <typename T>
+        void reduce(T const* first, T const* last, summary_stats<T>& stats,
+                    double& sum) {
+            for(; first != last; ++first) {
+                T const value = *first;
+                if(value != value) {
+                    ++stats.nans;
+                } else if(std::numeric_limits<T>::has_infinity
+                          && (value == std::numeric_limits<T>::infinity()
+                              || value == -std::numeric_limits<T>::infinity())) {
+                    ++stats.infs;
+                } else {
+                    if(stats.finite == 0 || value < stats.min) {
+                        stats.min = value;
+                    }
+                    if(stats.finite == 0 || value > stats.max) {
+                        stats.max = value;
+                    }
+                    sum += value;
+                    ++stats.finite;
+                }
+            }
+        }
+
+#if defined(__SSE2__)
+
+        /*
+         * Lane counters are flushed after this many iterations so that they
+         * can not overflow.
+         */
+        constexpr std::size_t simd_flush = std::size_t(1) << 30;
+
+        inline std::size_t simd_count(__m128i counts) {
+            std::int32_t lanes[4];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+            return std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        }
+
+        inline std::size_t simd_count64(__m128i counts) {
+            std::int64_t lanes[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), counts);
+            return std::size_t(lanes[0] + lanes[1]);
+        }
+
+        inline void reduce(float const* data, std::size_t size,
+                           summary_stats<float>& stats, double& sum) {
+            __m128 const inf = _mm_set1_ps(
+                std::numeric_limits<float>::infinity());
+            __m128 const abs_mask = _mm_castsi128_ps(
+                _mm_set1_epi32(0x7fffffff));
+            __m128 low = inf;
+            __m128 high = _mm_sub_ps(_mm_setzero_ps(), inf);
+            __m128d sums = _mm_setzero_pd();
+            std::size_t i = 0;
+            std::size_t nans = 0;
+            std::size_t infs = 0;
+            while(size - i >= 4) {
+                std::size_t const block_end = i + 4 * simd_flush < size
+                    ? i + 4 * simd_flush : size - (size - i) % 4;
+                __m128i nan_counts = _mm_setzero_si128();
+                __m128i inf_counts = _mm_setzero_si128();
+                for(; i < block_end; i += 4) {
+                    __m128 const x = _mm_loadu_ps(data + i);
+                    __m128 const absolute = _mm_and_ps(x, abs_mask);
+                    __m128 const nan = _mm_cmpunord_ps(x, x);
+                    __m128 const infinite = _mm_cmpeq_ps(absolute, inf);
+                    // false for NaN as well
+                    __m128 const finite = _mm_cmplt_ps(absolute, inf);
+                    nan_counts = _mm_sub_epi32(nan_counts,
+                                               _mm_castps_si128(nan));
+                    inf_counts = _mm_sub_epi32(inf_counts,
+                                               _mm_castps_si128(infinite));
+                    __m128 const value = _mm_and_ps(finite, x);
+                    low = _mm_min_ps(low, _mm_or_ps(
+                        value, _mm_andnot_ps(finite, inf)));
+                    high = _mm_max_ps(high, _mm_or_ps(
+                        value, _mm_andnot_ps(finite,
+                            _mm_sub_ps(_mm_setzero_ps(), inf))));
+                    sums = _mm_add_pd(sums, _mm_cvtps_pd(value));
+                    sums = _mm_add_pd(sums, _mm_cvtps_pd(
+                        _mm_movehl_ps(value, value)));
+                }
+                nans += simd_count(nan_counts);
+                infs += simd_count(inf_counts);
+            }
+
+            float lows[4];
+            float highs[4];
+            double partial[2];
+            _mm_storeu_ps(lows, low);
+            _mm_storeu_ps(highs, high);
+            _mm_storeu_pd(partial, sums);
+
+            stats.nans = nans;
+            stats.infs = infs;
+            stats.finite = i - nans - infs;
+            sum = partial[0] + partial[1];
+            if(stats.finite > 0) {
+                stats.min = lows[0];
+                stats.max = highs[0];
+                for(int lane = 1; lane < 4; ++lane) {
+                    stats.min = lows[lane] < stats.min ? lows[lane] : stats.min;
+                    stats.max = highs[lane] > stats.max ? highs[lane] : stats.max;
+                }
+            }
+            reduce(data + i, data + size, stats, sum);
+        }
+
+        inline void reduce(double const* data, std::size_t size,
+                           summary_stats<double>& stats, double& sum) {
+            __m128d const inf = _mm_set1_pd(
+                std::numeric_limits<double>::infinity());
+            __m128d const abs_mask = _mm_castsi128_pd(
+                _mm_set1_epi64x(0x7fffffffffffffff));
+            __m128d low = inf;
+            __m128d high = _mm_sub_pd(_mm_setzero_pd(), inf);
+            __m128d sums = _mm_setzero_pd();
+            __m128i nan_counts = _mm_setzero_si128();
+            __m128i inf_counts = _mm_setzero_si128();
+            std::size_t i = 0;
+            for(; size - i >= 2; i += 2) {
+                __m128d const x = _mm_loadu_pd(data + i);
+                __m128d const absolute = _mm_and_pd(x, abs_mask);
+                __m128d const nan = _mm_cmpunord_pd(x, x);
+                __m128d const infinite = _mm_cmpeq_pd(absolute, inf);
+                // false for NaN as well
+                __m128d const finite = _mm_cmplt_pd(absolute, inf);
+                nan_counts = _mm_sub_epi64(nan_counts,
+                                           _mm_castpd_si128(nan));
+                inf_counts = _mm_sub_epi64(inf_counts,
+                                           _mm_castpd_si128(infinite));
+                __m128d const value = _mm_and_pd(finite, x);
+                low = _mm_min_pd(low, _mm_or_pd(
+                    value, _mm_andnot_pd(finite, inf)));
+                high = _mm_max_pd(high, _mm_or_pd(
+                    value, _mm_andnot_pd(finite,
+                        _mm_sub_pd(_mm_setzero_pd(), inf))));
+                sums = _mm_add_pd(sums, value);
+            }
+
+            double lows[2];
+            double highs[2];
+            double partial[2];
+            _mm_storeu_pd(lows, low);
+            _mm_storeu_pd(highs, high);
+            _mm_storeu_pd(partial, sums);
+
+            stats.nans = simd_count64(nan_counts);
+            stats.infs = simd_count64(inf_counts);
+            stats.finite = i - stats.nans - stats.infs;
+            sum = partial[0] + partial[1];
+            if(stats.finite > 0) {
+                stats.min = lows[0] < lows[1] ? lows[0] : lows[1];
+                stats.max = highs[0] > highs[1] ? highs[0] : highs[1];
+            }
+            reduce(data + i, data + size, stats, sum);
+        }
+
+#else
+
+        inline void reduce(float const* data, std::size_t size,
+                           summary_stats<float>& stats, double& sum) {
+            reduce(data, data + size, stats, sum);
+        }
+
+        inline void reduce(double const* data, std::size_t size,
+                           summary_stats<double>& stats, double& sum) {
+            reduce(data, data + size, stats, sum);
+        }
+
+#endif
+
+        template <typename T>
+        void reduce(T const* data, std::size_t size,
+                    summary_stats<T>& stats, double& sum) {
+            reduce(data, data + size, stats, sum);
+        }
+
+        template <typename T>
+        summary_stats<T> statistics(T const* data, std::size_t size,
+                                    std::size_t bins) {
+            summary_stats<T> stats;
+            double sum = 0;
+            reduce(data, size, stats, sum);
+            if(stats.finite == 0) {
+                return stats;
+            }
+            stats.mean = sum / stats.finite;
+
+            if(bins > 0) {
+                stats.histogram.assign(bins, 0);
+                double const low = stats.min;
+                double const width = double(stats.max) - low;
+                double const scale = width > 0 ? bins / width : 0;
+                for(std::size_t i = 0; i < size; ++i) {
+                    double const value = data[i];
+                    if(std::isfinite(value)) {
+                        std::size_t bin =
+                            static_cast<std::size_t>((value - low) * scale);
+                        ++stats.histogram[bin < bins ? bin : bins - 1];
+                    }
+                }
+            }
+            return stats;
+        }
+
+    }
+
+    DUMP_DECL summary_stats<char>
+    statistics(char const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<unsigned char>
+    statistics(unsigned char const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<short>
+    statistics(short const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<unsigned short>
+    statistics(unsigned short const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<int>
+    statistics(int const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<unsigned int>
+    statistics(unsigned int const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<long>
+    statistics(long const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<unsigned long>
+    statistics(unsigned long const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<float>
+    statistics(float const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+    DUMP_DECL summary_stats<double>
+    statistics(double const* data, std::size_t size, std::size_t bins) {
+        return detail::statistics(data, size, bins);
+    }
+
+}
+
+#endif //DUMP_IMPL_SUMMARY_IPP
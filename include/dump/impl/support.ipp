@@ -0,0 +1,49 @@
+#ifndef DUMP_IMPL_SUPPORT_IPP
+#define DUMP_IMPL_SUPPORT_IPP
+
+#include "dump/support.hpp"
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include <sstream>
+
+namespace dump {
+
+    DUMP_DECL object_address::object_address(uintptr_t address,
+                                             std::type_info const& type)
+        : address(address), type(type.name()) {
+        boost::replace_all(this->type, "_", "");
+        boost::replace_all(this->type, "&", "");
+    }
+
+    DUMP_DECL std::string object_address::str() const {
+        std::ostringstream oss;
+        oss << "0x" <<  std::hex << address;
+        oss << "-" << type;
+        return oss.str();
+    }
+
+    DUMP_DECL boost::optional<object_address>
+    address_map::resolve(object_address const& address) {
+        auto const& alias = addresses.find(address);
+        if(alias == addresses.end()) {
+            return boost::none;
+        } else {
+            boost::optional<object_address> const& nested_alias =
+                resolve(alias->second);
+            if(nested_alias) {
+                return nested_alias.get();
+            } else {
+                return alias->second;
+            }
+        }
+    }
+
+    DUMP_DECL void address_map::add(object_address const& from,
+                                    object_address const& to) {
+        addresses.emplace(from, to);
+    }
+
+}
+
+#endif //DUMP_IMPL_SUPPORT_IPP
@@ -0,0 +1,359 @@
+#ifndef DUMP_IMPL_SVG_IPP
+#define DUMP_IMPL_SVG_IPP
+
+#include "dump/svg.hpp"
+
+#include <algorithm>
+#include <cstdint> // uintptr_t
+#include <cstdio>
+
+namespace dump {
+
+    namespace detail {
+
+        inline void write_xml_escaped(std::ostream& out, string_view text) {
+            std::size_t begin = 0;
+            for(std::size_t i = 0; i < text.size(); ++i) {
+                char const* entity;
+                switch(text[i]) {
+                case '&':
+                    entity = "&amp;";
+                    break;
+                case '<':
+                    entity = "&lt;";
+                    break;
+                case '>':
+                    entity = "&gt;";
+                    break;
+                case '"':
+                    entity = "&quot;";
+                    break;
+                default:
+                    continue;
+                }
+                out.write(text.data() + begin, i - begin);
+                out << entity;
+                begin = i + 1;
+            }
+            out.write(text.data() + begin, text.size() - begin);
+        }
+
+        inline void write_number(std::ostream& out, double number) {
+            char buffer[32];
+            int const size = std::snprintf(buffer, sizeof(buffer), "%.1f",
+                                           number);
+            out.write(buffer, size);
+        }
+
+        inline std::size_t text_lines(string_view text) {
+            return 1 + std::count(text.begin(), text.end(), '\n');
+        }
+
+    }
+
+    DUMP_DECL svg_format::svg_format(std::ostream& out, svg_options options)
+        : out(out), options(std::move(options)), open(false) {
+        start();
+    }
+
+    DUMP_DECL svg_format::~svg_format() {
+        finish();
+    }
+
+    DUMP_DECL void svg_format::start() {
+        format_policy::start();
+        nodes.clear();
+        aliases.addresses.clear();
+        frames.clear();
+        frames.emplace_back(false);
+        boxes.clear();
+        edges.clear();
+        open = true;
+    }
+
+    DUMP_DECL void svg_format::finish() {
+        if(!open) {
+            return;
+        }
+        open = false;
+        frame& root = frames.front();
+        if(root.node < boxes.size()) {
+            boxes[root.node].rows = std::move(root.rows);
+        }
+        print_graph();
+    }
+
+    DUMP_DECL object_address svg_format::resolve(object_ref ref) {
+        object_address address(reinterpret_cast<uintptr_t>(ref.address),
+                               *ref.type);
+        boost::optional<object_address> const& alias
+            = aliases.resolve(address);
+        if(alias) {
+            return alias.get();
+        } else {
+            return address;
+        }
+    }
+
+    DUMP_DECL void svg_format::print_graph() {
+        double const font = options.font_size;
+        double const char_width = font * 0.6;
+        double const line = font * 1.25;
+        double const padding = font / 2;
+        double const margin = font;
+
+        std::vector<layout_node> layout;
+        layout.reserve(boxes.size());
+        for(box const& b : boxes) {
+            std::size_t columns = text_columns(b.title);
+            std::size_t lines = 1;
+            for(row const& r : b.rows) {
+                columns = std::max(columns,
+                                   text_columns(r.label) + 1
+                                   + text_columns(r.text));
+                lines += detail::text_lines(r.text);
+            }
+            layout.push_back(layout_node{columns * char_width + 2 * padding,
+                                         lines * line + 2 * padding, 0, 0});
+        }
+        layered_layout(layout, edges, options.layout);
+
+        double width = 0;
+        double height = 0;
+        for(layout_node const& n : layout) {
+            width = std::max(width, n.x + n.width);
+            height = std::max(height, n.y + n.height);
+        }
+        for(layout_edge const& e : edges) {
+            for(layout_point const& p : e.points) {
+                width = std::max(width, p.x);
+            }
+        }
+        width += 2 * margin;
+        height += 2 * margin;
+
+        out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"";
+        detail::write_number(out, width);
+        out << "\" height=\"";
+        detail::write_number(out, height);
+        out << "\" font-family=\"monospace\" font-size=\"";
+        detail::write_number(out, font);
+        out << "\">\n"
+            << "<defs><marker id=\"arrow\" viewBox=\"0 0 10 10\" refX=\"10\""
+               " refY=\"5\" markerWidth=\"8\" markerHeight=\"8\""
+               " orient=\"auto\"><path d=\"M0,0 L10,5 L0,10 z\"/>"
+               "</marker></defs>\n"
+            << "<g transform=\"translate(";
+        detail::write_number(out, margin);
+        out << ',';
+        detail::write_number(out, margin);
+        out << ")\">\n";
+
+        out << "<g fill=\"none\" stroke=\"black\""
+               " marker-end=\"url(#arrow)\">\n";
+        for(layout_edge const& e : edges) {
+            out << "<polyline points=\"";
+            for(std::size_t i = 0; i < e.points.size(); ++i) {
+                if(i > 0) {
+                    out << ' ';
+                }
+                detail::write_number(out, e.points[i].x);
+                out << ',';
+                detail::write_number(out, e.points[i].y);
+            }
+            out << "\"/>\n";
+        }
+        out << "</g>\n";
+
+        for(std::size_t i = 0; i < boxes.size(); ++i) {
+            box const& b = boxes[i];
+            layout_node const& n = layout[i];
+            double const left = n.x + padding;
+            out << "<g>\n<rect x=\"";
+            detail::write_number(out, n.x);
+            out << "\" y=\"";
+            detail::write_number(out, n.y);
+            out << "\" width=\"";
+            detail::write_number(out, n.width);
+            out << "\" height=\"";
+            detail::write_number(out, n.height);
+            out << "\" fill=\"white\" stroke=\"black\"";
+            if(!b.hint.empty()) {
+                out << ' ' << b.hint;
+            }
+            out << "/>\n";
+            if(!b.rows.empty()) {
+                double const y = n.y + padding + line;
+                out << "<line x1=\"";
+                detail::write_number(out, n.x);
+                out << "\" y1=\"";
+                detail::write_number(out, y);
+                out << "\" x2=\"";
+                detail::write_number(out, n.x + n.width);
+                out << "\" y2=\"";
+                detail::write_number(out, y);
+                out << "\" stroke=\"gray\"/>\n";
+            }
+            out << "<text x=\"";
+            detail::write_number(out, left);
+            out << "\" y=\"";
+            detail::write_number(out, n.y + padding + font);
+            out << "\"><tspan font-weight=\"bold\">";
+            detail::write_xml_escaped(out, b.title);
+            out << "</tspan>";
+            for(row const& r : b.rows) {
+                out << "<tspan x=\"";
+                detail::write_number(out, left);
+                out << "\" dy=\"";
+                detail::write_number(out, line);
+                out << "\"><tspan font-style=\"italic\">";
+                detail::write_xml_escaped(out, r.label);
+                out << "</tspan> ";
+                string_view text = r.text;
+                std::size_t end;
+                while((end = text.find('\n')) != string_view::npos) {
+                    detail::write_xml_escaped(out, text.substr(0, end));
+                    out << "</tspan><tspan x=\"";
+                    detail::write_number(out, left);
+                    out << "\" dy=\"";
+                    detail::write_number(out, line);
+                    out << "\">";
+                    text = text.substr(end + 1);
+                }
+                detail::write_xml_escaped(out, text);
+                out << "</tspan>";
+            }
+            out << "</text>\n</g>\n";
+        }
+        out << "</g>\n</svg>\n";
+    }
+
+    DUMP_DECL bool svg_format::list_sizes() const {
+        return false;
+    }
+
+    DUMP_DECL void svg_format::enter(attribute const& attr) {
+        if(attr.inlined) {
+            // Add alias if childs of the child should connect to the parent
+            object_address const& parent_address = resolve(attr.parent);
+            object_address const& child_address = resolve(attr.child);
+            if(parent_address != child_address) {
+                aliases.add(child_address, parent_address);
+            }
+        }
+        frames.emplace_back(attr.inlined);
+    }
+
+    DUMP_DECL void svg_format::leave(attribute const& attr) {
+        frame& current = frames.back();
+        frame& outer = frames[frames.size() - 2];
+
+        if(attr.inlined) {
+            // List items are always listed inside the node
+            if(attr.item || !current.text.empty()) {
+                outer.rows.push_back(row{attr.label.to_string(),
+                                         current.text});
+            }
+            // and so are the inlined attributes of inlined attributes
+            for(row& r : current.rows) {
+                outer.rows.push_back(row{attr.label.to_string() + ' '
+                                         + r.label, std::move(r.text)});
+            }
+        } else if(current.node < boxes.size()) {
+            boxes[current.node].rows = std::move(current.rows);
+        }
+
+        // Only create edge if both nodes exist
+        if(!attr.inlined) {
+            auto const parent = nodes.find(resolve(attr.parent));
+            auto const child = nodes.find(resolve(attr.child));
+            if(parent != nodes.end() && child != nodes.end()) {
+                edges.push_back(layout_edge{parent->second, child->second,
+                                            {}});
+            }
+        }
+
+        frames.pop_back();
+    }
+
+    DUMP_DECL void svg_format::node(object_ref node, string_view text) {
+        frame& current = frames.back();
+        if(!current.inlined) {
+            object_address address(
+                reinterpret_cast<uintptr_t>(node.address), *node.type);
+            auto const created = nodes.emplace(address, boxes.size());
+            if(created.second) {
+                std::string hint;
+                if(options.hints) {
+                    auto const found = options.hints->find(address);
+                    if(found != options.hints->end()) {
+                        hint = found->second;
+                    }
+                }
+                current.node = boxes.size();
+                boxes.push_back(box{std::string(text.data(), text.size()),
+                                    {}, hint});
+            }
+        }
+    }
+
+    DUMP_DECL void svg_format::alias(object_ref wrapper, object_ref target) {
+        aliases.add(object_address(
+                        reinterpret_cast<uintptr_t>(wrapper.address),
+                        *wrapper.type),
+                    object_address(
+                        reinterpret_cast<uintptr_t>(target.address),
+                        *target.type));
+    }
+
+    DUMP_DECL void svg_format::type(std::type_info const& info) {
+    }
+
+    DUMP_DECL void svg_format::addr(void const* address) {
+    }
+
+    DUMP_DECL void svg_format::type_addr(std::type_info const& info,
+                                         void const* address) {
+    }
+
+    DUMP_DECL void svg_format::enumeration(string_view text) {
+        frames.back().text.append(text.data(), text.size());
+    }
+
+    DUMP_DECL void svg_format::value(string_view text) {
+        frames.back().text.append(text.data(), text.size());
+    }
+
+    DUMP_DECL void svg_format::block(string_view text) {
+        // omitted
+    }
+
+    DUMP_DECL void svg_format::bytes(unsigned char const* data,
+                                     std::size_t size) {
+        std::string& text = frames.back().text;
+        char line[hexdump_width];
+        for(std::size_t offset = 0; offset < size; offset += 16) {
+            if(offset > 0) {
+                text += '\n';
+            }
+            std::size_t const n = size - offset < 16 ? size - offset : 16;
+            text.append(line, hexdump_line(line, offset, data + offset, n));
+        }
+    }
+
+    DUMP_DECL void svg_format::err(string_view text) {
+        frames.back().text.append(text.data(), text.size());
+    }
+
+    DUMP_DECL void svg_format::err_type_addr(string_view text,
+                                             std::type_info const& info,
+                                             void const* address) {
+    }
+
+    DUMP_DECL void svg_format::undefined() {
+        frames.back().text += "undefined";
+    }
+
+}
+
+#endif //DUMP_IMPL_SVG_IPP
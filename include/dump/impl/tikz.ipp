@@ -0,0 +1,417 @@
+#ifndef DUMP_IMPL_TIKZ_IPP
+#define DUMP_IMPL_TIKZ_IPP
+
+#include "dump/tikz.hpp"
+#include "dump/latex_support.hpp"
+
+#include <algorithm>
+#include <cstdint> // uintptr_t
+#include <cstdio>
+#include <stdexcept>
+
+namespace dump {
+
+    namespace detail {
+        inline void append(std::ostream& out,
+                           std::ostringstream const& buffer) {
+            std::string const& text = buffer.str();
+            out.write(text.data(), text.size());
+        }
+
+        /*
+         * Estimated size of the nodes of `write_tikz_preamble` in pt: 10pt
+         * monospace text, an inner sep of 2mm per part and very thick
+         * lines.
+         */
+        constexpr double tikz_char_width = 5.5;
+        constexpr double tikz_line_height = 12;
+        constexpr double tikz_inner_sep = 5.69;
+        constexpr double tikz_line_width = 1.2;
+    }
+
+    DUMP_DECL tikz_format::tikz_format(std::ostream& parent, bool inlined)
+        : parent(parent), edge_file(nullptr), inlined(inlined), open(false) {
+        start();
+    }
+
+    DUMP_DECL tikz_format::tikz_format(std::ostream& parent,
+                                       address_hints hints, bool inlined)
+        : parent(parent), hints(hints), edge_file(nullptr), inlined(inlined),
+          open(false) {
+        start();
+    }
+
+    DUMP_DECL tikz_format::tikz_format(std::ostream& parent,
+                                       tikz_streaming streaming,
+                                       address_hints hints, bool inlined)
+        : parent(parent), hints(hints), streaming(streaming),
+          edge_file(nullptr), inlined(inlined), open(false) {
+        start();
+    }
+
+    DUMP_DECL tikz_format::tikz_format(std::ostream& parent,
+                                       layout_options layout,
+                                       address_hints hints, bool inlined)
+        : parent(parent), hints(hints), edge_file(nullptr), layout(layout),
+          inlined(inlined), open(false) {
+        start();
+    }
+
+    DUMP_DECL tikz_format::~tikz_format() {
+        finish();
+        if(edge_file) {
+            std::fclose(edge_file);
+        }
+    }
+
+    DUMP_DECL void tikz_format::start() {
+        format_policy::start();
+        nodes.clear();
+        aliases.addresses.clear();
+        frames.clear();
+        frames.emplace_back(inlined);
+        edges.str("");
+        if(edge_file) {
+            std::fclose(edge_file);
+            edge_file = nullptr;
+        }
+        placed.clear();
+        write_tikz_preamble(parent, !layout);
+        open = true;
+    }
+
+    DUMP_DECL void tikz_format::finish() {
+        if(!open) {
+            return;
+        }
+        open = false;
+        print_frame(frames.front(), nullptr);
+        if(edge_file) {
+            char buffer[1 << 14];
+            std::rewind(edge_file);
+            std::size_t size;
+            while((size = std::fread(buffer, 1, sizeof(buffer), edge_file))
+                  > 0) {
+                parent.write(buffer, size);
+            }
+            std::fclose(edge_file);
+            edge_file = nullptr;
+        }
+        detail::append(parent, edges);
+        parent << "\\end{tikzpicture}\n";
+    }
+
+    DUMP_DECL std::string tikz_format::escape(string_view text) {
+        std::ostringstream oss;
+        write_tikz_escaped(oss, text);
+        return oss.str();
+    }
+
+    DUMP_DECL void tikz_format::print_escaped(std::ostream& out,
+                                              string_view text) {
+        write_tikz_escaped(out, text);
+    }
+
+    DUMP_DECL object_address tikz_format::resolve(object_ref ref) {
+        object_address address(reinterpret_cast<uintptr_t>(ref.address),
+                               *ref.type);
+        boost::optional<object_address> const& alias
+            = aliases.resolve(address);
+        if(alias) {
+            return alias.get();
+        } else {
+            return address;
+        }
+    }
+
+    DUMP_DECL void tikz_format::print_node(frame& current) {
+        static char const* const tikz_nodepart[25] = {
+            "one", "two", "three", "four", "five", "six", "seven",
+            "eight", "nine", "ten", "eleven", "twelve", "thirteen",
+            "fourteen", "fifteen", "sixteen", "seventeen", "eighteen",
+            "nineteen", "twenty", "twentyone", "twentytwo",
+            "twentythree", "twentyfour", "twentyfive"};
+
+        if(current.create_node && !current.inlined) {
+            if(!current.node_id) {
+                throw std::runtime_error(
+                      "node_id not initialized in tikz_format");
+            }
+            std::ostringstream& out = current.out;
+            out << "\\node"
+                << '\n';
+            // Style
+            out << "\t"
+                << "["
+                << "rectangle split"
+                << ", rectangle split parts="
+                << 1+current.node_childs.size()
+                << ", text ragged";
+            if(hints) {
+                auto const& hint = hints->find(current.node_id.get());
+                if(hint != hints->end()) {
+                    out << ", " << hint->second;
+                }
+            }
+            if(layout) {
+                out << ", anchor=north";
+            }
+            out << "]"
+                << '\n';
+            // Identifier
+            out << "\t"
+                << " ("
+                << current.node_id.get().str()
+                << ")"
+                << '\n';
+            if(layout) {
+                std::size_t columns = text_columns(current.node_type);
+                for(auto const& child : current.node_childs) {
+                    if(child.second != boost::none) {
+                        columns = std::max(columns,
+                                           text_columns(child.first) + 1
+                                           + text_columns(*child.second));
+                    }
+                }
+                placement& node = placed[current.index];
+                node.split = static_cast<std::size_t>(out.tellp());
+                node.box.width = columns * detail::tikz_char_width
+                    + 2 * detail::tikz_inner_sep + detail::tikz_line_width;
+                node.box.height = (1 + current.node_childs.size())
+                    * (detail::tikz_line_height + 2 * detail::tikz_inner_sep)
+                    + detail::tikz_line_width;
+            }
+            // Content start
+            out << "\t"
+                << "{"
+                << '\n';
+            // Content
+            out << "\t\t"
+                << "\\textbf{"
+                << current.node_type
+                << "}"
+                << '\n';
+            unsigned i = 0;
+            for(auto const& child : current.node_childs) {
+                if(child.second != boost::none) {
+                    out << "\t\t"
+                        << "\\nodepart{"
+                        << ((++i < 25) ? tikz_nodepart[i] : "too many nodes")
+                        << "}"
+                        << '\n'
+                        << "\t\t"
+                        << "\\textit{";
+                    print_escaped(out, child.first);
+                    out << "}"
+                        << '\n'
+                        << "\t\t"
+                        << child.second.get()
+                        << '\n';
+                }
+            }
+            // Content end
+            out << "\t"
+                << "};"
+                << '\n';
+        }
+    }
+
+    DUMP_DECL void tikz_format::print_frame(frame& current, frame* outer) {
+        detail::append(current.eout, current.child_edges);
+        if(!current.inlined) {
+            print_node(current);
+            if(layout && current.create_node) {
+                placed[current.index].text = current.out.str();
+            } else {
+                detail::append(parent, current.out);
+            }
+        }
+        if(outer) {
+            detail::append(outer->child_edges, current.eout);
+        } else {
+            if(layout) {
+                print_placed();
+            }
+            detail::append(parent, current.eout);
+        }
+    }
+
+    DUMP_DECL void tikz_format::print_placed() {
+        std::vector<layout_node> boxes;
+        std::vector<std::size_t> parents;
+        boxes.reserve(placed.size());
+        parents.reserve(placed.size());
+        for(placement const& node : placed) {
+            boxes.push_back(node.box);
+            parents.push_back(node.parent);
+        }
+        tree_layout(boxes, parents, *layout);
+        for(std::size_t i = 0; i < placed.size(); ++i) {
+            std::string const& text = placed[i].text;
+            std::size_t const split = placed[i].split;
+            char position[64];
+            int const size = std::snprintf(
+                position, sizeof(position), "\t at (%.2fpt,%.2fpt)\n",
+                boxes[i].x + boxes[i].width / 2, 0 - boxes[i].y);
+            parent.write(text.data(), split);
+            parent.write(position, size);
+            parent.write(text.data() + split, text.size() - split);
+        }
+    }
+
+    DUMP_DECL std::ostream& tikz_format::edge_out(frame& outer) {
+        return streaming ? static_cast<std::ostream&>(edges) : outer.eout;
+    }
+
+    DUMP_DECL void tikz_format::spill_edges() {
+        if(!streaming || static_cast<std::size_t>(edges.tellp())
+                         < streaming->edge_buffer) {
+            return;
+        }
+        if(!edge_file) {
+            edge_file = std::tmpfile();
+            if(!edge_file) {
+                // keep the edges in memory
+                return;
+            }
+        }
+        std::string const& text = edges.str();
+        if(std::fwrite(text.data(), 1, text.size(), edge_file)
+           != text.size()) {
+            throw std::runtime_error(
+                "tikz_format: can not spill the edges");
+        }
+        edges.str("");
+    }
+
+    DUMP_DECL bool tikz_format::list_sizes() const {
+        return false;
+    }
+
+    DUMP_DECL void tikz_format::enter(attribute const& attr) {
+        if(attr.inlined) {
+            // Add alias if childs of the child should connect to the parent
+            object_address const& parent_address = resolve(attr.parent);
+            object_address const& child_address = resolve(attr.child);
+            if(parent_address != child_address) {
+                aliases.add(child_address, parent_address);
+            }
+        }
+        frames.emplace_back(attr.inlined);
+    }
+
+    DUMP_DECL void tikz_format::leave(attribute const& attr) {
+        frame& current = frames.back();
+        frame& outer = frames[frames.size() - 2];
+
+        if(attr.inlined) {
+            std::string const& child_out = current.out.str();
+            // List items are always listed inside the node
+            if(attr.item || child_out.size() > 0) {
+                outer.node_childs.emplace_back(attr.label, child_out);
+            }
+        }
+
+        object_address const& parent_address = resolve(attr.parent);
+        object_address const& child_address = resolve(attr.child);
+
+        // Only create edge if both nodes exist
+        if(!attr.inlined
+           && nodes.count(parent_address) > 0
+           && nodes.count(child_address) > 0) {
+            edge_out(outer) << "\\draw"
+                            << " (" << parent_address.str() << ")"
+                            << " edge[->]"
+                            << " (" << child_address.str() << ")"
+                            << ";"
+                            << '\n';
+            spill_edges();
+        }
+
+        print_frame(current, &outer);
+        frames.pop_back();
+    }
+
+    DUMP_DECL void tikz_format::node(object_ref node, string_view text) {
+        frame& current = frames.back();
+        if(!current.inlined) {
+            object_address address(
+                reinterpret_cast<uintptr_t>(node.address), *node.type);
+            if(nodes.insert(address).second) {
+                current.node_id = address;
+                current.node_type.assign(text.data(), text.size());
+                current.create_node = true;
+                if(layout) {
+                    // below the node of the closest attribute with one
+                    std::size_t above = no_parent;
+                    for(std::size_t i = frames.size() - 1; i-- > 0;) {
+                        if(frames[i].create_node) {
+                            above = frames[i].index;
+                            break;
+                        }
+                    }
+                    current.index = placed.size();
+                    placed.push_back(placement{std::string(), 0, above,
+                                               layout_node{0, 0, 0, 0}});
+                }
+            }
+        }
+    }
+
+    DUMP_DECL void tikz_format::alias(object_ref wrapper,
+                                      object_ref target) {
+        aliases.add(object_address(
+                        reinterpret_cast<uintptr_t>(wrapper.address),
+                        *wrapper.type),
+                    object_address(
+                        reinterpret_cast<uintptr_t>(target.address),
+                        *target.type));
+    }
+
+    DUMP_DECL void tikz_format::type(std::type_info const& info) {
+    }
+
+    DUMP_DECL void tikz_format::addr(void const* address) {
+    }
+
+    DUMP_DECL void tikz_format::type_addr(std::type_info const& info,
+                                          void const* address) {
+    }
+
+    DUMP_DECL void tikz_format::enumeration(string_view text) {
+        print_escaped(frames.back().out, text);
+    }
+
+    DUMP_DECL void tikz_format::value(string_view text) {
+        print_escaped(frames.back().out, text);
+    }
+
+    DUMP_DECL void tikz_format::block(string_view text) {
+        // omitted
+    }
+
+    DUMP_DECL void tikz_format::bytes(unsigned char const* data,
+                                      std::size_t size) {
+        // nodes are not aligned, so the lines are stacked explicitly
+        std::ostringstream& out = frames.back().out;
+        out << "\\shortstack[l]{";
+        write_latex_hexdump(out, data, size);
+        out << '}';
+    }
+
+    DUMP_DECL void tikz_format::err(string_view text) {
+        print_escaped(frames.back().out, text);
+    }
+
+    DUMP_DECL void tikz_format::err_type_addr(string_view text,
+                                              std::type_info const& info,
+                                              void const* address) {
+    }
+
+    DUMP_DECL void tikz_format::undefined() {
+        print_escaped(frames.back().out, "undefined");
+    }
+
+}
+
+#endif //DUMP_IMPL_TIKZ_IPP
@@ -0,0 +1,191 @@
+#ifndef DUMP_IMPL_TRAVERSAL_IPP
+#define DUMP_IMPL_TRAVERSAL_IPP
+
+#include "dump/traversal.hpp"
+
+#include <climits>
+#include <cstring>
+
+namespace dump {
+
+    namespace detail {
+
+        /*
+         * Constants and finalizer of MurmurHash3 (x64, 128 bit).
+         */
+        constexpr std::uint64_t murmur_c1 = 0x87c37b91114253d5ull;
+        constexpr std::uint64_t murmur_c2 = 0x4cf5ad432745937full;
+
+        inline std::uint64_t rotl(std::uint64_t x, int r) {
+            return (x << r) | (x >> (64 - r));
+        }
+
+        inline std::uint64_t fmix(std::uint64_t k) {
+            k ^= k >> 33;
+            k *= 0xff51afd7ed558ccdull;
+            k ^= k >> 33;
+            k *= 0xc4ceb9fe1a85ec53ull;
+            k ^= k >> 33;
+            return k;
+        }
+
+    }
+
+    DUMP_DECL std::string to_string(hash128 const& hash) {
+        unsigned char bytes[16];
+        for(int i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<unsigned char>(hash.high >> (56 - 8 * i));
+            bytes[8 + i] = static_cast<unsigned char>(hash.low >> (56 - 8 * i));
+        }
+        std::string text(32, '0');
+        hex_encode(&text[0], bytes, sizeof(bytes));
+        return text;
+    }
+
+    DUMP_DECL hash_format::state::state()
+        : h1(0x9e3779b97f4a7c15ull), h2(0xc2b2ae3d27d4eb4full), length(0) {}
+
+    DUMP_DECL void hash_format::state::mix(std::uint64_t word) {
+        std::uint64_t k1 = word * detail::murmur_c1;
+        k1 = detail::rotl(k1, 31) * detail::murmur_c2;
+        h1 ^= k1;
+        h1 = detail::rotl(h1, 27) + h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        std::uint64_t k2 = word * detail::murmur_c2;
+        k2 = detail::rotl(k2, 33) * detail::murmur_c1;
+        h2 ^= k2;
+        h2 = detail::rotl(h2, 31) + h1;
+        h2 = h2 * 5 + 0x38495ab5;
+
+        ++length;
+    }
+
+    DUMP_DECL void hash_format::state::mix(char token, void const* data,
+                                           std::size_t size) {
+        // the size separates adjacent tokens
+        mix((std::uint64_t(static_cast<unsigned char>(token)) << 56) ^ size);
+        unsigned char const* bytes = static_cast<unsigned char const*>(data);
+        for(; size >= 8; size -= 8, bytes += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8);
+            mix(word);
+        }
+        if(size > 0) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, bytes, size);
+            mix(word);
+        }
+    }
+
+    DUMP_DECL hash128 hash_format::state::digest() const {
+        std::uint64_t a = h1 ^ length;
+        std::uint64_t b = h2 ^ length;
+        a += b;
+        b += a;
+        a = detail::fmix(a);
+        b = detail::fmix(b);
+        a += b;
+        b += a;
+        return {a, b};
+    }
+
+    DUMP_DECL hash_format::hash_format()
+        : frames(1) {}
+
+    DUMP_DECL void hash_format::reset() {
+        frames.assign(1, state());
+    }
+
+    DUMP_DECL void hash_format::start() {
+        format_policy::start();
+        reset();
+    }
+
+    DUMP_DECL hash128 hash_format::digest() const {
+        return frames.front().digest();
+    }
+
+    DUMP_DECL void hash_format::child(attribute const& attr,
+                                      hash128 const& digest) {
+        char const flags = static_cast<char>(
+            'a' + (attr.last_child ? 1 : 0) + (attr.inlined ? 2 : 0)
+            + (attr.item ? 4 : 0));
+        state& parent = frames.back();
+        parent.mix(flags, attr.label.data(), attr.label.size());
+        parent.mix(digest.low);
+        parent.mix(digest.high);
+    }
+
+    DUMP_DECL void hash_format::enter(attribute const& attr) {
+        frames.emplace_back();
+    }
+
+    DUMP_DECL void hash_format::leave(attribute const& attr) {
+        hash128 const& digest = frames.back().digest();
+        frames.pop_back();
+        child(attr, digest);
+    }
+
+    DUMP_DECL void hash_format::node(object_ref node, string_view text) {
+        mix('n', text);
+    }
+
+    DUMP_DECL void hash_format::type(std::type_info const& info) {
+        mix('t', string_view(info.name()));
+    }
+
+    DUMP_DECL void hash_format::addr(void const* address) {
+        mix('@', string_view());
+    }
+
+    DUMP_DECL void hash_format::enumeration(string_view text) {
+        mix('e', text);
+    }
+
+    DUMP_DECL void hash_format::value(string_view text) {
+        mix('v', text);
+    }
+
+    DUMP_DECL void hash_format::string(string_view text) {
+        mix('s', text);
+    }
+
+    DUMP_DECL void hash_format::integer(long number) {
+        frames.back().mix('i', &number, sizeof(number));
+    }
+
+    DUMP_DECL void hash_format::unsigned_integer(unsigned long number) {
+        // unsigned numbers which are written like signed ones hash alike,
+        // the larger ones have the same bits as negative ones
+        char const token = number <= static_cast<unsigned long>(LONG_MAX)
+            ? 'i' : 'u';
+        frames.back().mix(token, &number, sizeof(number));
+    }
+
+    DUMP_DECL void hash_format::real(double number) {
+        // as written, so numbers which are printed alike hash alike
+        number_buffer buffer;
+        mix('r', format(buffer, number));
+    }
+
+    DUMP_DECL void hash_format::block(string_view text) {
+        mix('b', text);
+    }
+
+    DUMP_DECL void hash_format::bytes(unsigned char const* data,
+                                      std::size_t size) {
+        frames.back().mix('x', data, size);
+    }
+
+    DUMP_DECL void hash_format::err(string_view text) {
+        mix('!', text);
+    }
+
+    DUMP_DECL void hash_format::undefined() {
+        mix('u', string_view());
+    }
+
+}
+
+#endif //DUMP_IMPL_TRAVERSAL_IPP
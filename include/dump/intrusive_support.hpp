@@ -0,0 +1,52 @@
+#ifndef DUMP_INTRUSIVE_SUPPORT_HPP
+#define DUMP_INTRUSIVE_SUPPORT_HPP
+
+#include "dump/traits.hpp"
+
+#include <boost/intrusive/intrusive_fwd.hpp>
+
+namespace dump {
+
+    /*
+     * Boost.Intrusive, the linked objects are listed where they are. Their
+     * owners may dump them as well, the tikz_dumper draws a single node
+     * for both. `size()` of containers without a constant time size walks
+     * the links once more.
+     */
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::list<_Args...>>
+        : list_traversal_traits<boost::intrusive::list<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::slist<_Args...>>
+        : list_traversal_traits<boost::intrusive::slist<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::set<_Args...>>
+        : list_traversal_traits<boost::intrusive::set<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::multiset<_Args...>>
+        : list_traversal_traits<boost::intrusive::multiset<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::avl_set<_Args...>>
+        : list_traversal_traits<boost::intrusive::avl_set<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::avl_multiset<_Args...>>
+        : list_traversal_traits<boost::intrusive::avl_multiset<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::unordered_set<_Args...>>
+        : list_traversal_traits<boost::intrusive::unordered_set<_Args...>> {};
+
+    template <typename... _Args>
+    struct traversal_traits<boost::intrusive::unordered_multiset<_Args...>>
+        : list_traversal_traits<
+              boost::intrusive::unordered_multiset<_Args...>> {};
+
+}
+
+#endif //DUMP_INTRUSIVE_SUPPORT_HPP
@@ -0,0 +1,75 @@
+#ifndef DUMP_LATEX_BUILD_HPP
+#define DUMP_LATEX_BUILD_HPP
+
+#include "dump/config.hpp"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    struct latex_build_options {
+        /**
+         * Command run in the directory of every source, with the file name
+         * appended. It has to write the PDF next to the source.
+         */
+        std::string command = "lualatex -interaction=batchmode -halt-on-error";
+
+        /**
+         * Number of compilers running at the same time, one per hardware
+         * thread if 0.
+         */
+        unsigned int jobs = 0;
+
+        /**
+         * Directory of the cached PDFs, `dump-latex-cache` in the temporary
+         * directory if empty.
+         */
+        std::string cache;
+    };
+
+    struct latex_build_result {
+        std::string source;
+        std::string pdf;
+
+        /**
+         * Whether the PDF was copied from the cache instead of compiled.
+         */
+        bool cached;
+
+        /**
+         * Exit status of the command, -1 if it could not be run or the
+         * PDF is missing.
+         */
+        int status;
+
+        double seconds;
+    };
+
+    /**
+     * Compile LaTeX sources, e.g. written by `fs`, to PDF files next to
+     * them with a pool of `jobs` processes.
+     *
+     * PDFs are cached by a hash of the command and the contents of the
+     * source, so unchanged sources are not compiled again. The output of
+     * a command goes to a `.build.log` file next to the source. Results
+     * are in the order of `sources`.
+     */
+    DUMP_DECL std::vector<latex_build_result>
+    latex_build(std::vector<std::string> const& sources,
+                latex_build_options const& options = latex_build_options());
+
+    /**
+     * Table of the results, slowest first.
+     */
+    DUMP_DECL void write_latex_build_report(
+        std::ostream& out, std::vector<latex_build_result> const& results);
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/latex_build.ipp"
+#endif
+
+#endif //DUMP_LATEX_BUILD_HPP
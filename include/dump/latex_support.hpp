@@ -1,50 +1,75 @@
 #ifndef DUMP_LATEX_SUPPORT_HPP
 #define DUMP_LATEX_SUPPORT_HPP
 
-#include <sstream>
+#include "dump/config.hpp"
+#include "dump/format.hpp"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
 
 namespace dump {
 
     struct latex_support {
-        std::string get_header() const {
-            std::ostringstream oss;
-            oss << "\\documentclass{minimal}" << std::endl;
-
-            oss << "\\usepackage{luatex85}" << std::endl;
-
-            oss << "\\usepackage[T1]{fontenc}" << std::endl;
-            oss << "\\usepackage[utf8]{inputenc}" << std::endl;
-            oss << "\\usepackage{textcomp}" << std::endl;
-
-            oss << "\\usepackage{color}" << std::endl;
-            oss << "\\usepackage{listings}" << std::endl;
-
-            oss << "\\usepackage{tikz}" << std::endl;
-
-            oss << "\\usetikzlibrary{graphdrawing,graphs,shapes}" << std::endl;
-            oss << "\\usegdlibrary{layered}" << std::endl;
-
-            oss << "\\usepackage{forest}" << std::endl;
-
-            oss << "\\usepackage[active,tightpage]{preview}" << std::endl;
-
-            oss << "\\PreviewEnvironment{lstlisting}" << std::endl;
-            oss << "\\PreviewEnvironment{tikzpicture}" << std::endl;
-            oss << "\\PreviewEnvironment{forest}" << std::endl;
-
-            oss << "\\usepackage[numbered]{bookmark}" << std::endl;
-
-            oss << "\\begin{document}" << std::endl;
-            return oss.str();
-        }
-
-        std::string get_footer() const {
-            std::ostringstream oss;
-            oss << "\\end{document}" << std::endl;
-            return oss.str();
-        }
+        /**
+         * Preamble and start of a document. The graphdrawing library, which
+         * needs LuaLaTeX, is only loaded for the `layered layout` of the
+         * `tikz_dumper`; pictures with a `layout_options` or
+         * `forest_layout` place their nodes themselves.
+         */
+        DUMP_DECL std::string get_header(bool layered = true) const;
+
+        DUMP_DECL std::string get_footer() const;
     };
 
+    /**
+     * Opening of the `forest` environment with the tree style used by the
+     * `forest_dumper`.
+     */
+    DUMP_DECL void write_forest_preamble(std::ostream& out);
+
+    /**
+     * Opening of the `tikzpicture` environment of a `forest_dumper` with a
+     * `forest_layout`, in the node style of the forest.
+     */
+    DUMP_DECL void write_forest_layout_preamble(std::ostream& out);
+
+    /**
+     * Opening of the `tikzpicture` environment with the graph style used by
+     * the `tikz_dumper`, without the `layered layout` of graphdrawing if the
+     * nodes are placed already.
+     */
+    DUMP_DECL void write_tikz_preamble(std::ostream& out,
+                                       bool layered = true);
+
+    /**
+     * Escape text for a node of the LaTeX forest package.
+     *
+     * Commas, brackets and equal signs are escaped as well because of their
+     * syntactical meaning in the forest package as they are used to
+     * configure additional settings inside a node or subtree.
+     */
+    DUMP_DECL void write_forest_escaped(std::ostream& out, string_view text);
+
+    /**
+     * Escape text for a TikZ node. Arrows and comparisons are set in math
+     * mode.
+     */
+    DUMP_DECL void write_tikz_escaped(std::ostream& out, string_view text);
+
+    /**
+     * Write binary data as hexdump in `\texttt` lines separated by `\\`.
+     * Spaces are kept as `~` and characters of the ASCII column with a
+     * meaning in TeX, TikZ or forest are replaced by dots.
+     */
+    DUMP_DECL void write_latex_hexdump(std::ostream& out,
+                                       unsigned char const* data,
+                                       std::size_t size);
+
 }
 
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/latex_support.ipp"
+#endif
+
 #endif //DUMP_LATEX_SUPPORT_HPP
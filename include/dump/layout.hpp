@@ -0,0 +1,96 @@
+#ifndef DUMP_LAYOUT_HPP
+#define DUMP_LAYOUT_HPP
+
+#include "dump/config.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace dump {
+
+    struct layout_point {
+        double x;
+        double y;
+    };
+
+    /**
+     * Box of a node. `width` and `height` are given, the position of its
+     * top left corner is computed.
+     */
+    struct layout_node {
+        double width;
+        double height;
+        double x;
+        double y;
+    };
+
+    /**
+     * Edge between two nodes given by their index. The computed `points`
+     * lead from the border of `from` to the border of `to`.
+     */
+    struct layout_edge {
+        std::size_t from;
+        std::size_t to;
+        std::vector<layout_point> points;
+    };
+
+    struct layout_options {
+        /**
+         * Horizontal space between two nodes of a layer
+         */
+        double node_spacing = 20;
+
+        /**
+         * Vertical space between two layers
+         */
+        double layer_spacing = 40;
+
+        /**
+         * Passes up and down the layers to reduce crossings and straighten
+         * the edges
+         */
+        std::size_t sweeps = 4;
+    };
+
+    /**
+     * Sugiyama style layered layout of a directed graph, the edges
+     * pointing downwards as far as possible.
+     *
+     * The back edges of a depth-first search are reversed to remove the
+     * cycles, the nodes are put on the layer of the longest path reaching
+     * them and edges spanning several layers get a bend point on each.
+     * Crossings are reduced by sorting the layers by the barycenters of
+     * their neighbours, and the horizontal positions are the closest ones
+     * to these barycenters keeping the order and spacing of the layers.
+     * Every step takes linear time except for sorting the layers.
+     */
+    DUMP_DECL void layered_layout(std::vector<layout_node>& nodes,
+                                  std::vector<layout_edge>& edges,
+                                  layout_options const& options =
+                                      layout_options());
+
+    constexpr std::size_t no_parent = static_cast<std::size_t>(-1);
+
+    /**
+     * Tidy layout of a forest after Reingold and Tilford, in the linear
+     * time variant of Walker's algorithm by Buchheim, Jünger and Leipert.
+     *
+     * `parents` holds the index of the parent of every node, or `no_parent`
+     * for the roots, which are placed side by side. Parents have to come
+     * before their children, which are ordered by their index. Every
+     * parent is centered above its children, and equal subtrees are drawn
+     * alike. The nodes of a depth share a layer. `options.sweeps` is not
+     * used.
+     */
+    DUMP_DECL void tree_layout(std::vector<layout_node>& nodes,
+                               std::vector<std::size_t> const& parents,
+                               layout_options const& options =
+                                   layout_options());
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/layout.ipp"
+#endif
+
+#endif //DUMP_LAYOUT_HPP
@@ -0,0 +1,240 @@
+#ifndef DUMP_MULTI_INDEX_SUPPORT_HPP
+#define DUMP_MULTI_INDEX_SUPPORT_HPP
+
+#include "dump/traits.hpp"
+
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace dump {
+
+    template <typename... _Args>
+    struct traversal_traits<boost::multi_index_container<_Args...>>
+        : list_traversal_traits<boost::multi_index_container<_Args...>> {};
+
+    /**
+     * Kind of an index of a `multi_index_container`.
+     */
+    enum class index_kind {
+        ordered,
+        ranked,
+        hashed,
+        sequenced,
+        random_access
+    };
+
+    template <>
+    struct traversal_traits<index_kind> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, index_kind const& op) {
+            switch(op) {
+            case index_kind::ordered:
+                dumper.cEnum("ordered");
+                break;
+            case index_kind::ranked:
+                dumper.cEnum("ranked");
+                break;
+            case index_kind::hashed:
+                dumper.cEnum("hashed");
+                break;
+            case index_kind::sequenced:
+                dumper.cEnum("sequenced");
+                break;
+            case index_kind::random_access:
+                dumper.cEnum("random access");
+                break;
+            }
+        }
+    };
+
+    namespace detail {
+
+        template <typename Index, typename = void>
+        struct is_ranked : std::false_type {};
+
+        template <typename Index>
+        struct is_ranked<Index, void_t<decltype(std::declval<Index const&>()
+            .rank(std::declval<typename Index::const_iterator>()))>>
+            : std::true_type {};
+
+        template <typename Index, typename = void>
+        struct is_ordered : std::false_type {};
+
+        template <typename Index>
+        struct is_ordered<Index, void_t<decltype(
+            std::declval<Index const&>().key_comp())>>
+            : std::true_type {};
+
+        template <typename Index, typename = void>
+        struct is_hashed : std::false_type {};
+
+        template <typename Index>
+        struct is_hashed<Index, void_t<decltype(
+            std::declval<Index const&>().bucket_count())>>
+            : std::true_type {};
+
+        template <typename Index, typename = void>
+        struct is_random_access : std::false_type {};
+
+        template <typename Index>
+        struct is_random_access<Index, void_t<decltype(
+            std::declval<Index const&>().at(std::size_t()))>>
+            : std::integral_constant<bool, !is_hashed<Index>::value> {};
+
+        /*
+         * The kinds are told apart by the members of their interfaces as
+         * the index classes are internal to Boost.MultiIndex.
+         */
+        template <typename Index>
+        constexpr index_kind kind_of() {
+            return is_ranked<Index>::value ? index_kind::ranked
+                 : is_ordered<Index>::value ? index_kind::ordered
+                 : is_hashed<Index>::value ? index_kind::hashed
+                 : is_random_access<Index>::value ? index_kind::random_access
+                 : index_kind::sequenced;
+        }
+
+        /*
+         * Position of the index with tag or number `Tag` among the indices
+         * of `Container`.
+         */
+        template <typename Container, typename Tag>
+        constexpr std::size_t index_number() {
+            return boost::mpl::distance<
+                typename boost::mpl::begin<
+                    typename Container::index_type_list>::type,
+                typename Container::template index<Tag>::iter>::value;
+        }
+
+    }
+
+    /**
+     * Items of a `multi_index_container` in the order of one of its
+     * indices, see `by_index` and `key_range`.
+     */
+    template <typename Container, typename Index>
+    struct index_items {
+        typedef typename Index::const_iterator iterator;
+
+        Container const& container;
+        std::size_t number;
+        index_kind kind;
+        iterator first;
+        iterator last;
+        bool ranged;
+    };
+
+    namespace detail {
+
+        template <typename Container, typename Index>
+        index_items<Container, Index>
+        make_index_items(Container const& ops, Index const& index,
+                         std::size_t number,
+                         typename Index::const_iterator first,
+                         typename Index::const_iterator last, bool ranged) {
+            return {ops, number, kind_of<Index>(), first, last, ranged};
+        }
+
+        template <typename Container, typename Index, typename Key>
+        index_items<Container, Index>
+        make_key_range(Container const& ops, Index const& index,
+                       std::size_t number, Key const& lo, Key const& hi) {
+            static_assert(is_ordered<Index>::value,
+                          "key ranges need an ordered or ranked index");
+            auto const first = index.lower_bound(lo);
+            // empty unless `lo < hi`, the bounds would be out of order
+            auto const last = index.key_comp()(lo, hi)
+                ? index.lower_bound(hi) : first;
+            return make_index_items(ops, index, number, first, last, true);
+        }
+
+    }
+
+    /**
+     * List the items of `ops` in the order of its index `N` instead of the
+     * first one:
+     *
+     *     this->cAttr(obj, "by name", dump::by_index<1>(obj.cache), true);
+     *
+     * The number and kind of the index are written before the items.
+     */
+    template <int N, typename Container>
+    index_items<Container, typename Container::template nth_index<N>::type>
+    by_index(Container const& ops) {
+        auto const& index = ops.template get<N>();
+        return detail::make_index_items(ops, index, N, index.begin(),
+                                        index.end(), false);
+    }
+
+    /**
+     * List the items of `ops` in the order of the index tagged `Tag`.
+     */
+    template <typename Tag, typename Container>
+    index_items<Container, typename Container::template index<Tag>::type>
+    by_index(Container const& ops) {
+        auto const& index = ops.template get<Tag>();
+        return detail::make_index_items(
+            ops, index, detail::index_number<Container, Tag>(),
+            index.begin(), index.end(), false);
+    }
+
+    /**
+     * List the items of `ops` with keys in `[lo, hi)` of its ordered index
+     * `N`. Only the range is visited, the bounds are found with the
+     * `lower_bound` of the index. The number of items in the range is
+     * written as `count` after the size of the whole container. The range
+     * is empty unless `lo` comes before `hi`.
+     */
+    template <int N, typename Container, typename Key>
+    index_items<Container, typename Container::template nth_index<N>::type>
+    key_range(Container const& ops, Key const& lo, Key const& hi) {
+        return detail::make_key_range(ops, ops.template get<N>(), N, lo, hi);
+    }
+
+    /**
+     * List the items of `ops` with keys in `[lo, hi)` of the ordered index
+     * tagged `Tag`.
+     */
+    template <typename Tag, typename Container, typename Key>
+    index_items<Container, typename Container::template index<Tag>::type>
+    key_range(Container const& ops, Key const& lo, Key const& hi) {
+        return detail::make_key_range(
+            ops, ops.template get<Tag>(),
+            detail::index_number<Container, Tag>(), lo, hi);
+    }
+
+    template <typename Container, typename Index>
+    struct traversal_traits<index_items<Container, Index>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper,
+                          index_items<Container, Index> const& op) {
+            Container const& ops = op.container;
+            std::size_t count = op.ranged
+                ? std::distance(op.first, op.last) : ops.size();
+            bool const sizes = dumper.policy.list_sizes();
+            dumper.cAlias(op, ops);
+            dumper.cAttr(ops, "index", op.number, false, true);
+            dumper.cAttr(ops, "kind", op.kind,
+                         count == 0 && !op.ranged && !sizes, true);
+            if(sizes) {
+                dumper.cAttr(ops, "size", ops.size(),
+                             count == 0 && !op.ranged, true);
+            }
+            if(op.ranged) {
+                dumper.cAttr(ops, "count", count, count == 0, true);
+            }
+            for(auto it = op.first; count > 0; ++it) {
+                dumper.cListAttr(ops, "item", *it, --count == 0);
+            }
+        }
+    };
+
+}
+
+#endif //DUMP_MULTI_INDEX_SUPPORT_HPP
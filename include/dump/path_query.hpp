@@ -0,0 +1,148 @@
+#ifndef DUMP_PATH_QUERY_HPP
+#define DUMP_PATH_QUERY_HPP
+
+#include "dump/config.hpp"
+#include "dump/format.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    /**
+     * Pattern of attribute labels from the root to the selected subtrees,
+     * separated by `/`:
+     *
+     * - `label` matches an attribute with this label, e.g. `main engine`
+     * - `*` matches any attribute
+     * - `**` matches any number of attributes, including none
+     * - `[n]` after a label or `*` only matches the n-th list item,
+     *   counted from 0, e.g. `tires/item[2]/width`
+     *
+     * Malformed patterns throw `std::invalid_argument`.
+     */
+    struct path_query {
+        struct segment {
+            enum kind_type { label, any, any_path } kind;
+            std::string text;
+
+            /**
+             * Index of the list item, or -1 for any.
+             */
+            long index;
+        };
+
+        std::vector<segment> segments;
+
+        DUMP_DECL explicit path_query(string_view pattern);
+
+        /**
+         * States are the set of matched segments as bit mask. The bit
+         * after the last segment is set once the whole pattern matched.
+         */
+        DUMP_DECL std::uint64_t start() const;
+
+        DUMP_DECL std::uint64_t step(std::uint64_t state, string_view label,
+                                     long index) const;
+
+        std::uint64_t accepted() const {
+            return std::uint64_t(1) << segments.size();
+        }
+
+    private:
+        DUMP_DECL std::uint64_t closure(std::uint64_t state) const;
+    };
+
+    /**
+     * Restriction of a dump to some of its attributes, see
+     * `format_policy::selection`. Consulted before every attribute and
+     * list, so the attributes which are left out are never visited.
+     */
+    struct attribute_filter {
+        virtual ~attribute_filter() {}
+
+        /**
+         * Whether the attribute is dumped. May mark it as last child.
+         */
+        virtual bool enter(string_view label, bool item, bool inlined,
+                           bool& last_child) = 0;
+
+        /**
+         * Leave an attribute which was entered.
+         */
+        virtual void leave() = 0;
+
+        /**
+         * Narrow the items `[first, last)` of a list which are dumped.
+         */
+        virtual void select_items(std::size_t& first, std::size_t& last) = 0;
+    };
+
+    /**
+     * State of a dump restricted to a `path_query`, see `select`.
+     *
+     * The selection is dumped twice. The first pass (`probing`) only
+     * enters attributes which may still lead to a match and records which
+     * of them do. The second pass enters only those, marking the last one
+     * of every node as last child, and everything below a match.
+     */
+    struct path_selection : attribute_filter {
+        path_query const& query;
+        bool probing;
+
+        DUMP_DECL explicit path_selection(path_query const& query);
+
+        /**
+         * Whether the attribute is dumped. Updates `last_child` in the
+         * second pass.
+         */
+        DUMP_DECL bool enter(string_view label, bool item, bool inlined,
+                             bool& last_child) override;
+
+        DUMP_DECL void leave() override;
+
+        /**
+         * Narrow the items `[first, last)` of a list which may match. Items
+         * before `first` are counted as skipped.
+         */
+        DUMP_DECL void select_items(std::size_t& first,
+                                    std::size_t& last) override;
+
+        /**
+         * Start the second pass.
+         */
+        DUMP_DECL void replay();
+
+    private:
+        static constexpr std::size_t none = std::size_t(-1);
+
+        struct frame {
+            std::uint64_t state;
+            std::size_t items;
+            std::size_t record;
+            std::size_t last_match;
+            bool full;
+        };
+
+        struct record {
+            std::size_t end;
+            bool match;
+            bool last;
+        };
+
+        std::vector<frame> frames;
+        std::vector<record> records;
+        std::size_t cursor;
+
+        DUMP_DECL void matched(frame& parent, std::size_t record);
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/path_query.ipp"
+#endif
+
+#endif //DUMP_PATH_QUERY_HPP
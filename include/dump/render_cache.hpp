@@ -0,0 +1,176 @@
+#ifndef DUMP_RENDER_CACHE_HPP
+#define DUMP_RENDER_CACHE_HPP
+
+#include "dump/config.hpp"
+#include "dump/traits.hpp"
+#include "dump/traversal.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+namespace dump {
+
+    /**
+     * Output of subtrees by identity, dumper, policy, options and version,
+     * with at most `capacity` bytes which are evicted least recently used
+     * first.
+     *
+     * Only policies with a `cache_context` are cached, currently the
+     * `plaintext_format` and the `console_format`. Their cached output is
+     * re-indented to the prefix where it is spliced. Not thread-safe.
+     */
+    struct render_cache {
+        struct key {
+            object_ref object;
+            std::type_info const* format;
+            std::type_info const* dumper;
+            std::uint64_t version;
+            std::string context;
+
+            /**
+             * The `dump_options` which change the output of a subtree
+             */
+            bool collapse_runs = false;
+            std::size_t max_value_chars = 0;
+            std::size_t max_value_lines = 0;
+
+            DUMP_DECL bool operator==(key const& other) const;
+        };
+
+        struct key_hash {
+            DUMP_DECL std::size_t operator()(key const& k) const;
+        };
+
+        DUMP_DECL explicit render_cache(std::size_t capacity);
+
+        render_cache(render_cache const&) = delete;
+        render_cache& operator=(render_cache const&) = delete;
+
+        /**
+         * The cached output or null. Marks the entry as recently used.
+         */
+        DUMP_DECL std::string const* find(key const& k);
+
+        /**
+         * Cache `text`, evicting old entries while over capacity. Outputs
+         * larger than the capacity are not cached.
+         */
+        DUMP_DECL void insert(key k, std::string text);
+
+        DUMP_DECL void clear();
+
+        std::size_t capacity() const {
+            return limit;
+        }
+
+        /**
+         * Bytes of all cached outputs and their contexts.
+         */
+        std::size_t bytes() const {
+            return used;
+        }
+
+        std::size_t size() const {
+            return index.size();
+        }
+
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+
+    private:
+        typedef std::pair<key, std::string> entry;
+
+        std::size_t limit;
+        std::size_t used = 0;
+
+        /**
+         * Most recently used first.
+         */
+        std::list<entry> entries;
+        std::unordered_map<key, std::list<entry>::iterator, key_hash> index;
+
+        static std::size_t cost(entry const& e) {
+            return e.first.context.size() + e.second.size();
+        }
+    };
+
+    /**
+     * Subtree whose output is cached, see `cached`.
+     */
+    template <typename T>
+    struct cached_subtree {
+        T const& object;
+        std::uint64_t version;
+    };
+
+    /**
+     * Cache the output of an immutable subtree in the `render_cache` of
+     * the dump options, if any:
+     *
+     *     this->cAttr(obj, "ast", dump::cached(*obj.ast, obj.generation),
+     *                 true);
+     *
+     * Entries are looked up by the address and type of `obj`, the dumper,
+     * the policy, its options and `version`, so the version has to change
+     * whenever the subtree does. Cycles within the subtree are reported
+     * as they were when it was cached.
+     */
+    template <typename T>
+    cached_subtree<T> cached(T const& obj, std::uint64_t version = 0) {
+        return {obj, version};
+    }
+
+    template <typename T>
+    struct traversal_traits<cached_subtree<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, cached_subtree<T> const& op) {
+            format_policy& policy = dumper.policy;
+            render_cache* cache = policy.options.cache;
+            std::string context;
+            dumper.cAlias(op, op.object);
+            // selections dump only a part of the subtree
+            if(cache == nullptr || policy.selection != nullptr
+               || !policy.cache_context(context)) {
+                dumper.cWrapped(op.object);
+                return;
+            }
+
+            dump_options const& options = policy.options;
+            render_cache::key k{object_ref(op.object), &typeid(policy),
+                                &typeid(Dumper), op.version,
+                                std::move(context), options.collapse_runs,
+                                options.max_value_chars,
+                                options.max_value_lines};
+            if(std::string const* text = cache->find(k)) {
+                policy.splice(*text);
+                return;
+            }
+
+            std::stringbuf buffer;
+            policy.capture(&buffer);
+            try {
+                dumper.cWrapped(op.object);
+            } catch(...) {
+                policy.release();
+                throw;
+            }
+            policy.release();
+            std::string text = buffer.str();
+            policy.splice(text);
+            cache->insert(std::move(k), std::move(text));
+        }
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/render_cache.ipp"
+#endif
+
+#endif //DUMP_RENDER_CACHE_HPP
@@ -0,0 +1,67 @@
+#ifndef DUMP_SESSION_HPP
+#define DUMP_SESSION_HPP
+
+#include "dump/config.hpp"
+#include "dump/traversal.hpp"
+
+#include <ostream>
+#include <utility>
+
+namespace dump {
+
+    /**
+     * Policy which is kept for many dumps, so that its frames, prefixes,
+     * visited nodes and buffers keep their memory:
+     *
+     *     dump::session<dump::plaintext_format> session;
+     *     for(auto const& obj : objects) {
+     *         session.dump<car_dumper>(std::cout, obj);
+     *     }
+     *
+     * `Dumper` is constructed as a child of the session's policy for every
+     * dump, so it has to derive from `traversal` or one of the dumper
+     * bases. The policy writes to a stream of the session which is pointed
+     * to the buffer of `out` during a dump. Once warmed up, dumps with the
+     * text policies allocate nothing. The `tikz_format` still allocates
+     * its node buffers.
+     */
+    template <typename Format>
+    struct session {
+        /**
+         * `args` are passed to the policy after its stream.
+         */
+        template <typename... Args>
+        explicit session(Args&&... args)
+            : stream(nullptr), format(stream, std::forward<Args>(args)...) {
+            // the constructor started a dump without a buffer
+            format.finish();
+        }
+
+        session(session const&) = delete;
+        session& operator=(session const&) = delete;
+
+        template <typename Dumper, typename T>
+        void dump(std::ostream& out, T const& obj) {
+            stream.rdbuf(out.rdbuf());
+            try {
+                format.start();
+                Dumper{static_cast<format_policy&>(format)}(obj);
+                format.finish();
+            } catch(...) {
+                stream.rdbuf(nullptr);
+                throw;
+            }
+            stream.rdbuf(nullptr);
+        }
+
+        /**
+         * Stream of the policy, writes to the buffer of the current dump.
+         */
+        std::ostream stream;
+
+        Format format;
+    };
+
+}
+
+#endif //DUMP_SESSION_HPP
@@ -0,0 +1,303 @@
+#ifndef DUMP_STD_SUPPORT_HPP
+#define DUMP_STD_SUPPORT_HPP
+
+#include "dump/format.hpp"
+#include "dump/traits.hpp"
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#  include <optional>
+#  include <string_view>
+#  include <variant>
+#endif
+
+namespace dump {
+
+    template <typename T, std::size_t N>
+    struct traversal_traits<std::array<T, N>>
+        : list_traversal_traits<std::array<T, N>> {};
+
+    template <typename T, typename Allocator>
+    struct traversal_traits<std::vector<T, Allocator>>
+        : list_traversal_traits<std::vector<T, Allocator>> {};
+
+    template <typename T, typename Allocator>
+    struct traversal_traits<std::deque<T, Allocator>>
+        : list_traversal_traits<std::deque<T, Allocator>> {};
+
+    template <typename T, typename Allocator>
+    struct traversal_traits<std::list<T, Allocator>>
+        : list_traversal_traits<std::list<T, Allocator>> {};
+
+    template <typename Key, typename Compare, typename Allocator>
+    struct traversal_traits<std::set<Key, Compare, Allocator>>
+        : list_traversal_traits<std::set<Key, Compare, Allocator>> {};
+
+    template <typename Key, typename T, typename Compare, typename Allocator>
+    struct traversal_traits<std::map<Key, T, Compare, Allocator>>
+        : list_traversal_traits<std::map<Key, T, Compare, Allocator>> {};
+
+    /*
+     * Byte buffers are dumped as hexdump instead of one item per byte.
+     */
+    template <std::size_t N>
+    struct traversal_traits<std::array<char, N>>
+        : byte_traversal_traits<std::array<char, N>> {};
+
+    template <std::size_t N>
+    struct traversal_traits<std::array<signed char, N>>
+        : byte_traversal_traits<std::array<signed char, N>> {};
+
+    template <std::size_t N>
+    struct traversal_traits<std::array<unsigned char, N>>
+        : byte_traversal_traits<std::array<unsigned char, N>> {};
+
+    template <typename Allocator>
+    struct traversal_traits<std::vector<char, Allocator>>
+        : byte_traversal_traits<std::vector<char, Allocator>> {};
+
+    template <typename Allocator>
+    struct traversal_traits<std::vector<signed char, Allocator>>
+        : byte_traversal_traits<std::vector<signed char, Allocator>> {};
+
+    template <typename Allocator>
+    struct traversal_traits<std::vector<unsigned char, Allocator>>
+        : byte_traversal_traits<std::vector<unsigned char, Allocator>> {};
+
+    namespace detail {
+
+        /*
+         * Bits as string of '0' and '1', grouped by `group_bits`. Up to 64
+         * bits fit on the line of the attribute.
+         */
+        template <typename Dumper, typename Bits>
+        void dump_bits(Dumper& dumper, Bits const& op, std::size_t size,
+                       std::size_t count, std::string const& bits) {
+            std::string const& grouped = group_bits(bits);
+            dumper.cAttr(op, "size", size, false, true);
+            dumper.cAttr(op, "count", count, false, true);
+            dumper.cAttr(op, "bits", grouped, true, size <= 64);
+        }
+
+    }
+
+    /*
+     * Bits are written from the highest to the lowest like
+     * `std::bitset::to_string`.
+     */
+    template <std::size_t N>
+    struct traversal_traits<std::bitset<N>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::bitset<N> const& op) {
+            detail::dump_bits(dumper, op, N, op.count(), op.to_string());
+        }
+    };
+
+    /*
+     * Bits are written in index order.
+     */
+    template <typename Allocator>
+    struct traversal_traits<std::vector<bool, Allocator>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper,
+                          std::vector<bool, Allocator> const& op) {
+            std::string bits(op.size(), '0');
+            std::size_t count = 0;
+            for(std::size_t i = 0; i < op.size(); ++i) {
+                if(op[i]) {
+                    bits[i] = '1';
+                    ++count;
+                }
+            }
+            detail::dump_bits(dumper, op, op.size(), count, bits);
+        }
+    };
+
+    template <typename T1, typename T2>
+    struct traversal_traits<std::pair<T1, T2>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::pair<T1, T2> const& op) {
+            dumper.cAttr(op, "first", op.first, false);
+            dumper.cAttr(op, "second", op.second, true);
+        }
+    };
+
+    template <typename... Ts>
+    struct traversal_traits<std::tuple<Ts...>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::tuple<Ts...> const& op) {
+            apply(dumper, op, std::index_sequence_for<Ts...>());
+        }
+
+        template <typename Dumper, std::size_t... Is>
+        static void apply(Dumper& dumper, std::tuple<Ts...> const& op,
+                          std::index_sequence<Is...>) {
+            int expand[] = {0, (dumper.cListAttr(op, "item",
+                                                 std::get<Is>(op),
+                                                 Is+1 == sizeof...(Ts)),
+                                0)...};
+            (void)expand;
+        }
+    };
+
+    /*
+     * C strings are dumped like `std::string`, without copying them.
+     */
+    template <>
+    struct traversal_traits<char const*> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, char const* op) {
+            if(op != nullptr) {
+                dumper.cString(op);
+            } else {
+                dumper.cUndefined();
+            }
+        }
+    };
+
+    template <>
+    struct traversal_traits<char*> : traversal_traits<char const*> {};
+
+    namespace detail {
+
+        /*
+         * Pointers are followed to single objects only. The others, like
+         * `void*` or `unique_ptr<T[]>`, are not implemented.
+         */
+        template <typename T>
+        using if_pointee = typename std::enable_if<
+            std::is_object<T>::value && !std::is_array<T>::value>::type;
+
+    }
+
+    template <typename T>
+    struct traversal_traits<T*, detail::if_pointee<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, T* const& op) {
+            if(op != nullptr) {
+                dumper.cPointee(op, *op);
+            } else {
+                dumper.cUndefined();
+            }
+        }
+    };
+
+    template <typename T, typename Deleter>
+    struct traversal_traits<std::unique_ptr<T, Deleter>,
+                            detail::if_pointee<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper,
+                          std::unique_ptr<T, Deleter> const& op) {
+            if(op != nullptr) {
+                dumper.cPointee(op, *op);
+            } else {
+                dumper.cUndefined();
+            }
+        }
+    };
+
+    template <typename T>
+    struct traversal_traits<std::shared_ptr<T>, detail::if_pointee<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::shared_ptr<T> const& op) {
+            if(op != nullptr) {
+                dumper.cPointee(op, *op);
+            } else {
+                dumper.cUndefined();
+            }
+        }
+    };
+
+    /*
+     * Expired pointers are undefined. The target is kept alive while it is
+     * dumped.
+     */
+    template <typename T>
+    struct traversal_traits<std::weak_ptr<T>, detail::if_pointee<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::weak_ptr<T> const& op) {
+            std::shared_ptr<T> const& target = op.lock();
+            if(target != nullptr) {
+                dumper.cPointee(op, *target);
+            } else {
+                dumper.cUndefined();
+            }
+        }
+    };
+
+    /*
+     * A relaxed load, dumping does not synchronize with writers.
+     */
+    template <typename T>
+    struct traversal_traits<std::atomic<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::atomic<T> const& op) {
+            T const value = op.load(std::memory_order_relaxed);
+            dumper.cWrapped(value);
+        }
+    };
+
+#if __cplusplus >= 201703L
+
+    template <>
+    struct traversal_traits<std::string_view> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::string_view op) {
+            dumper.cString(string_view(op.data(), op.size()));
+        }
+    };
+
+    template <std::size_t N>
+    struct traversal_traits<std::array<std::byte, N>>
+        : byte_traversal_traits<std::array<std::byte, N>> {};
+
+    template <typename Allocator>
+    struct traversal_traits<std::vector<std::byte, Allocator>>
+        : byte_traversal_traits<std::vector<std::byte, Allocator>> {};
+
+    template <typename T>
+    struct traversal_traits<std::optional<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::optional<T> const& op) {
+            if(op) {
+                dumper.cAlias(op, *op);
+                dumper.cWrapped(*op);
+            } else {
+                dumper.cUndefined();
+            }
+        }
+    };
+
+    template <typename... Ts>
+    struct traversal_traits<std::variant<Ts...>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, std::variant<Ts...> const& op) {
+            if(op.valueless_by_exception()) {
+                dumper.cUndefined();
+            } else {
+                std::visit(variant_visitor<Dumper, std::variant<Ts...>>{
+                               dumper, op},
+                           op);
+            }
+        }
+    };
+
+#endif
+
+}
+
+#endif //DUMP_STD_SUPPORT_HPP
@@ -0,0 +1,176 @@
+#ifndef DUMP_SUMMARY_HPP
+#define DUMP_SUMMARY_HPP
+
+#include "dump/config.hpp"
+#include "dump/traits.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace dump {
+
+    struct summary_options {
+        /**
+         * Number of histogram bins between min and max, none if 0
+         */
+        std::size_t bins = 0;
+
+        /**
+         * Number of samples listed from the start
+         */
+        std::size_t head = 0;
+
+        /**
+         * Number of samples listed from the end
+         */
+        std::size_t tail = 0;
+    };
+
+    /**
+     * Statistics of an array. NaN and infinite values are only counted,
+     * `min`, `max` and `mean` are those of the other values and only
+     * defined if there are any.
+     */
+    template <typename T>
+    struct summary_stats {
+        std::size_t finite = 0;
+        std::size_t nans = 0;
+        std::size_t infs = 0;
+        T min = T();
+        T max = T();
+        double mean = 0;
+        std::vector<std::size_t> histogram;
+    };
+
+    /*
+     * Floating point statistics use SSE2 reductions where available.
+     */
+    DUMP_DECL summary_stats<char>
+    statistics(char const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<unsigned char>
+    statistics(unsigned char const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<short>
+    statistics(short const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<unsigned short>
+    statistics(unsigned short const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<int>
+    statistics(int const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<unsigned int>
+    statistics(unsigned int const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<long>
+    statistics(long const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<unsigned long>
+    statistics(unsigned long const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<float>
+    statistics(float const* data, std::size_t size, std::size_t bins);
+    DUMP_DECL summary_stats<double>
+    statistics(double const* data, std::size_t size, std::size_t bins);
+
+    /**
+     * Element types with a `statistics` overload.
+     */
+    typedef type_list<char, unsigned char, short, unsigned short, int,
+                      unsigned int, long, unsigned long, float, double>
+        summary_types;
+
+    /**
+     * Contiguous samples, e.g. the head of a summary.
+     */
+    template <typename T>
+    struct samples {
+        T const* first;
+        T const* last;
+
+        T const* begin() const {
+            return first;
+        }
+
+        T const* end() const {
+            return last;
+        }
+
+        std::size_t size() const {
+            return last - first;
+        }
+    };
+
+    /**
+     * Summary of a contiguous array of arithmetic values as created by
+     * `summarize`.
+     */
+    template <typename T>
+    struct summary {
+        T const* data;
+        std::size_t size;
+        summary_options options;
+    };
+
+    /**
+     * Dump `ops` as a summary instead of listing every element:
+     *
+     *     this->cAttr(obj, "samples", dump::summarize(obj.samples), true);
+     *
+     * Works with every container with contiguous `data()` and `size()`,
+     * e.g. `std::vector`, `std::array` and `small_vector`, of one of the
+     * `summary_types`.
+     */
+    template <typename Container>
+    summary<typename std::remove_cv<
+        typename std::remove_pointer<
+            decltype(std::declval<Container const&>().data())>::type>::type>
+    summarize(Container const& ops,
+              summary_options options = summary_options()) {
+        return {ops.data(), ops.size(), options};
+    }
+
+    template <typename T>
+    struct traversal_traits<summary<T>> {
+        static_assert(detail::contains<T, summary_types>::value,
+                      "summaries are only supported for the summary_types");
+
+        template <typename Dumper>
+        static void apply(Dumper& dumper, summary<T> const& op) {
+            summary_options const& options = op.options;
+            summary_stats<T> const& stats =
+                statistics(op.data, op.size, options.bins);
+            std::size_t const head =
+                options.head < op.size ? options.head : op.size;
+            std::size_t const tail =
+                options.tail < op.size - head ? options.tail : op.size - head;
+
+            dumper.cNode(op, "Summary");
+            dumper.cAttr(op, "size", op.size, false, true);
+            if(stats.finite > 0) {
+                dumper.cAttr(op, "min", stats.min, false, true);
+                dumper.cAttr(op, "max", stats.max, false, true);
+                dumper.cAttr(op, "mean", stats.mean, false, true);
+            }
+            if(std::numeric_limits<T>::has_quiet_NaN) {
+                dumper.cAttr(op, "nan", stats.nans, false, true);
+                dumper.cAttr(op, "inf", stats.infs, false, true);
+            }
+            if(!stats.histogram.empty()) {
+                dumper.cAttr(op, "histogram", stats.histogram,
+                             head == 0 && tail == 0);
+            }
+            if(head > 0) {
+                samples<T> const first{op.data, op.data + head};
+                dumper.cAttr(op, "head", first, tail == 0);
+            }
+            if(tail > 0) {
+                samples<T> const last{op.data + op.size - tail,
+                                      op.data + op.size};
+                dumper.cAttr(op, "tail", last, true);
+            }
+        }
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/summary.ipp"
+#endif
+
+#endif //DUMP_SUMMARY_HPP
@@ -1,21 +1,16 @@
 #ifndef DUMP_SUPPORT_HPP
 #define DUMP_SUPPORT_HPP
 
-#include "dump/x3_support.hpp"
+#include "dump/config.hpp"
 
-#include <boost/algorithm/string/replace.hpp>
 #include <boost/optional.hpp>
-#include <boost/type_index.hpp>
-#include <boost/variant.hpp>
 
 #include <cstdint> // uintptr_t
 #include <map>
 #include <memory>
 #include <set>
-#include <sstream>
-#include <utility>
-
-#include <iostream>
+#include <string>
+#include <typeinfo>
 
 namespace dump {
 
@@ -24,19 +19,15 @@ namespace dump {
         std::string type;
 
         template <typename T>
-        object_address(T const& obj) {
-            address = reinterpret_cast<uintptr_t>(std::addressof(obj));
-            type = boost::typeindex::type_id<T>().raw_name();
-            boost::replace_all(type, "_", "");
-            boost::replace_all(type, "&", "");
-        }
+        object_address(T const& obj)
+            : object_address(
+                  reinterpret_cast<uintptr_t>(std::addressof(obj)),
+                  typeid(T)) {}
 
-        std::string str() const {
-            std::ostringstream oss;
-            oss << "0x" <<  std::hex << address;
-            oss << "-" << type;
-            return oss.str();
-        }
+        DUMP_DECL object_address(uintptr_t address,
+                                 std::type_info const& type);
+
+        DUMP_DECL std::string str() const;
 
         bool operator<(object_address const& other) const {
             if(address < other.address) {
@@ -65,73 +56,14 @@ namespace dump {
     using address_hints =
         std::shared_ptr<std::map<object_address, std::string>>;
 
-    struct ptr_visitor {
-        template <typename T>
-        object_address operator()(std::shared_ptr<T> const& obj) {
-            if(obj) {
-                return object_address(*obj);
-            } else {
-                return object_address(obj);
-            }
-        }
-
-        template <typename... _Args>
-        object_address operator()(boost::variant<_Args...> const& obj) {
-            return boost::apply_visitor(*this, obj);
-        }
-
-        template <typename T>
-        object_address operator()(boost::optional<T> const& obj) {
-            if(obj) {
-                return object_address(obj.get());
-            } else {
-                return object_address(obj);
-            }
-        }
-
-        template <typename T,
-              typename std::enable_if<is_variant<T>::value, bool>::type = false>
-        object_address operator()(T const& obj) {
-            return boost::apply_visitor(*this, obj);
-        }
-
-        template <typename T>
-        object_address operator()(boost::spirit::x3::forward_ast<T> const& obj) {
-            return object_address(obj.get());
-        }
-
-        template <typename T,
-              typename std::enable_if<!is_variant<T>::value, bool>::type = false>
-        object_address operator()(T const& obj) const {
-            return object_address(obj);
-        }
-    };
-
     struct address_map {
         std::map<object_address, object_address> addresses;
 
-        boost::optional<object_address>
-        resolve(object_address const& address) {
-            auto const& alias = addresses.find(address);
-            if(alias == addresses.end()) {
-                return boost::none;
-            } else {
-                /*
-                std::cout << "Resolved " << alias->first.str() << " to "
-                          << alias->second.str() << std::endl;
-                */
-                boost::optional<object_address> const& nested_alias =
-                    resolve(alias->second);
-                if(nested_alias) {
-                    return nested_alias.get();
-                } else {
-                    return alias->second;
-                }
-            }
-        }
+        DUMP_DECL boost::optional<object_address>
+        resolve(object_address const& address);
 
-       template <typename T>
-       object_address resolve(T const& obj) {
+        template <typename T>
+        object_address resolve(T const& obj) {
             object_address const& address
                 = object_address(obj);
             boost::optional<object_address> const& alias
@@ -144,66 +76,16 @@ namespace dump {
             }
         }
 
-        template <typename T>
-        void add(T const& obj) {
-            auto const& o_address = object_address(obj);
-            auto const& a_address = ptr_visitor{}(obj);
-            if(o_address != a_address) {
-                addresses.emplace(o_address, a_address);
-            } else {
-                throw std::runtime_error("No alias found");
-            }
-        }
-
-        void add(object_address const& from, object_address const& to) {
-            addresses.emplace(from, to);
-        }
+        DUMP_DECL void add(object_address const& from,
+                           object_address const& to);
     };
 
     typedef std::shared_ptr<address_map> address_map_ptr;
 
-    struct type_id_visitor {
-        template <typename T>
-        std::string operator()(std::shared_ptr<T> const& obj) {
-            if(obj) {
-                return (*this)(*obj);
-            } else {
-                return boost::typeindex::type_id<std::shared_ptr<T>>().pretty_name();
-            }
-        }
-
-        template <typename... _Args>
-        std::string operator()(boost::variant<_Args...> const& obj) {
-            return boost::apply_visitor(*this, obj);
-        }
-
-        template <typename T>
-        std::string operator()(boost::optional<T> const& obj) {
-            if(obj) {
-                return (*this)(obj.get());
-            } else {
-                return boost::typeindex::type_id<boost::optional<T>>().pretty_name();
-            }
-        }
-
-        template <typename T,
-              typename std::enable_if<is_variant<T>::value, bool>::type = false>
-        std::string operator()(T const& ast) {
-            return boost::apply_visitor(*this, ast);
-        }
-
-        template <typename T>
-        std::string operator()(boost::spirit::x3::forward_ast<T> const& ast) {
-            return (*this)(ast.get());
-        }
-
-        template <typename T,
-              typename std::enable_if<!is_variant<T>::value, bool>::type = false>
-        std::string operator()(T const& obj) const {
-            return boost::typeindex::type_id<T>().pretty_name();
-        }
-    };
-
 }
 
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/support.ipp"
+#endif
+
 #endif //DUMP_SUPPORT_HPP
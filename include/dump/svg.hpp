@@ -0,0 +1,155 @@
+#ifndef DUMP_SVG_HPP
+#define DUMP_SVG_HPP
+
+#include "dump/config.hpp"
+#include "dump/format.hpp"
+#include "dump/layout.hpp"
+#include "dump/support.hpp"
+#include "dump/traversal.hpp"
+
+#include <cstddef>
+#include <map>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace dump {
+
+    struct svg_options {
+        layout_options layout;
+
+        /**
+         * Size of the monospace font in pixels, which also determines the
+         * size of the nodes
+         */
+        double font_size = 12;
+
+        /**
+         * Attributes added to the `rect` of a node, e.g. `fill="yellow"`
+         */
+        address_hints hints;
+    };
+
+    /**
+     * Formatting policy of the svg_dumper.
+     *
+     * Creates the same nodes, edges and aliases as the `tikz_format`, but
+     * places the nodes itself with a `layered_layout` and writes an SVG
+     * picture, so no TeX installation is needed and large graphs are
+     * drawn in seconds. The graph is kept until the end of the dump.
+     */
+    struct svg_format : format_policy {
+        /**
+         * Inlined attribute shown in a node
+         */
+        struct row {
+            std::string label;
+            std::string text;
+        };
+
+        struct frame {
+            bool inlined;
+
+            /**
+             * Content of an inlined attribute
+             */
+            std::string text;
+
+            /**
+             * Index of the node created by the attribute, if any
+             */
+            std::size_t node;
+
+            std::vector<row> rows;
+
+            explicit frame(bool inlined)
+                : inlined(inlined), node(static_cast<std::size_t>(-1)) {}
+        };
+
+        struct box {
+            std::string title;
+            std::vector<row> rows;
+            std::string hint;
+        };
+
+        std::ostream& out;
+        svg_options options;
+
+        /**
+         * Index of the created nodes
+         */
+        std::map<object_address, std::size_t> nodes;
+
+        address_map aliases;
+        std::vector<frame> frames;
+        std::vector<box> boxes;
+        std::vector<layout_edge> edges;
+
+        DUMP_DECL explicit svg_format(std::ostream& out,
+                                      svg_options options = svg_options());
+        DUMP_DECL ~svg_format();
+
+        svg_format(svg_format const&) = delete;
+        svg_format& operator=(svg_format const&) = delete;
+
+        DUMP_DECL void start() override;
+        DUMP_DECL void finish() override;
+
+        DUMP_DECL object_address resolve(object_ref ref);
+
+        /**
+         * Lay out the graph and write the picture.
+         */
+        DUMP_DECL void print_graph();
+
+        DUMP_DECL bool list_sizes() const override;
+        DUMP_DECL void enter(attribute const& attr) override;
+        DUMP_DECL void leave(attribute const& attr) override;
+        DUMP_DECL void node(object_ref node, string_view text) override;
+        DUMP_DECL void alias(object_ref wrapper, object_ref target) override;
+        DUMP_DECL void type(std::type_info const& info) override;
+        DUMP_DECL void addr(void const* address) override;
+        DUMP_DECL void type_addr(std::type_info const& info,
+                                 void const* address) override;
+        DUMP_DECL void enumeration(string_view text) override;
+        DUMP_DECL void value(string_view text) override;
+        DUMP_DECL void block(string_view text) override;
+
+        DUMP_DECL void bytes(unsigned char const* data,
+                             std::size_t size) override;
+        DUMP_DECL void err(string_view text) override;
+        DUMP_DECL void err_type_addr(string_view text,
+                                     std::type_info const& info,
+                                     void const* address) override;
+        DUMP_DECL void undefined() override;
+
+    private:
+        bool open;
+    };
+
+    /**
+     * Base class for data structure dumpers writing an SVG graph.
+     */
+    template <typename Derived>
+    struct svg_dumper
+        : private detail::format_storage<svg_format>,
+          public traversal<Derived>
+    {
+        typedef svg_dumper<Derived> Self;
+
+        svg_dumper(std::ostream& out, svg_options options = svg_options())
+            : traversal<Derived>(this->own(out, std::move(options))) {}
+
+        svg_dumper(format_policy& policy)
+            : traversal<Derived>(policy) {}
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/svg.ipp"
+#endif
+
+#endif //DUMP_SVG_HPP
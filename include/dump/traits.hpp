@@ -0,0 +1,252 @@
+#ifndef DUMP_TRAITS_HPP
+#define DUMP_TRAITS_HPP
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace dump {
+
+    namespace detail {
+
+        template <typename... Ts>
+        struct make_void {
+            typedef void type;
+        };
+
+        template <typename... Ts>
+        using void_t = typename make_void<Ts...>::type;
+
+        using std::begin;
+        using std::end;
+
+        template <typename T>
+        using begin_t = decltype(begin(std::declval<T const&>()));
+
+        template <typename T>
+        using end_t = decltype(end(std::declval<T const&>()));
+
+        template <typename T, typename = void>
+        struct is_range : std::false_type {};
+
+        template <typename T>
+        struct is_range<T, void_t<begin_t<T>, end_t<T>>>
+            : std::true_type {};
+
+        template <typename T, typename = void>
+        struct has_size : std::false_type {};
+
+        template <typename T>
+        struct has_size<T, void_t<decltype(std::declval<T const&>().size())>>
+            : std::true_type {};
+
+        template <typename Iterator, typename = void>
+        struct is_forward_iterator : std::false_type {};
+
+        template <typename Iterator>
+        struct is_forward_iterator<Iterator, void_t<
+            typename std::iterator_traits<Iterator>::iterator_category>>
+            : std::is_base_of<
+                  std::forward_iterator_tag,
+                  typename std::iterator_traits<Iterator>::iterator_category> {};
+
+    }
+
+    template <typename Range>
+    struct range_traversal_traits;
+
+    /**
+     * Tells the dumpers how to traverse a type which has no call operator
+     * overload in the dumper itself.
+     *
+     * Support for containers and third party types is opt-in: each
+     * `*_support.hpp` header specializes this template for the types it
+     * covers, so translation units only pay for the libraries they dump.
+     * Types without a specialization are dumped as a range if they have
+     * `begin` and `end` (see `range_traversal_traits`), everything else is
+     * reported as not implemented.
+     *
+     * Specializations may use the following members of the dumper:
+     *
+     * - `dumper(obj)` dispatches to the call operators of the dumper
+     * - `dumper.cItems(container)` lists the items of a container
+     * - `dumper.cAlias(wrapper, target)` announces that `wrapper` stands
+     *   for `target` (the tikz_dumper merges both into a single node)
+     * - `dumper.cPointee(pointer, target)` dumps the target of a pointer
+     *   unless it is already being dumped further up, which cuts cycles
+     * - `dumper.cWrapped(target)` dumps the target of a wrapper unless
+     *   its type is excluded
+     * - `dumper.cString(text)` dumps text like a `std::string`
+     * - `dumper.cBytes(data, size)` dumps binary data as hexdump
+     * - `dumper.cUndefined()` marks an empty wrapper
+     */
+    template <typename T, typename Enable = void>
+    struct traversal_traits {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, T const& obj) {
+            apply(dumper, obj, detail::is_range<T>());
+        }
+
+        template <typename Dumper>
+        static void apply(Dumper& dumper, T const& obj, std::true_type) {
+            range_traversal_traits<T>::apply(dumper, obj);
+        }
+
+        template <typename Dumper>
+        static void apply(Dumper& dumper, T const& obj, std::false_type) {
+            dumper.cErrTypeAddr("not implemented", obj);
+        }
+    };
+
+    /**
+     * Visitor which dumps the active member of a variant.
+     */
+    template <typename Dumper, typename Variant>
+    struct variant_visitor {
+        typedef void result_type;
+
+        Dumper& dumper;
+        Variant const& variant;
+
+        template <typename T>
+        void operator()(T const& value) const {
+            dumper.cAlias(variant, value);
+            dumper.cWrapped(value);
+        }
+    };
+
+    /**
+     * Traversal of containers which are dumped as a list of items.
+     */
+    template <typename Container>
+    struct list_traversal_traits {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, Container const& ops) {
+            dumper.cItems(ops);
+        }
+    };
+
+    /**
+     * Traversal of contiguous byte containers which are dumped as hexdump.
+     */
+    template <typename Container>
+    struct byte_traversal_traits {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, Container const& ops) {
+            dumper.cAttr(ops, "size", ops.size(), false, true);
+            if(ops.size() > 0) {
+                dumper.cBytes(ops.data(), ops.size());
+            }
+        }
+    };
+
+    /**
+     * Traversal of anything with `begin` and `end`, e.g. views and custom
+     * containers, without copying it.
+     *
+     * Ranges with a `size()` are dumped like any other list. Otherwise the
+     * size is omitted and the items are streamed, looking one item ahead
+     * to know the last one. Items of input ranges can not be revisited
+     * after incrementing, so they are dumped from a copy. As copies share
+     * their address the tikz_dumper may merge their nodes.
+     */
+    template <typename Range>
+    struct range_traversal_traits {
+        typedef detail::begin_t<Range> iterator;
+
+        template <typename Dumper>
+        static void apply(Dumper& dumper, Range const& ops) {
+            apply(dumper, ops, detail::has_size<Range>(),
+                  detail::is_forward_iterator<iterator>());
+        }
+
+        template <typename Dumper, typename Forward>
+        static void apply(Dumper& dumper, Range const& ops,
+                          std::true_type, Forward) {
+            dumper.cItems(ops);
+        }
+
+        template <typename Dumper>
+        static void apply(Dumper& dumper, Range const& ops,
+                          std::false_type, std::true_type) {
+            using std::begin;
+            using std::end;
+            auto it = begin(ops);
+            auto last = end(ops);
+            while(it != last) {
+                auto next = it;
+                ++next;
+                dumper.cListAttr(ops, "item", *it, next == last);
+                it = next;
+            }
+        }
+
+        template <typename Dumper>
+        static void apply(Dumper& dumper, Range const& ops,
+                          std::false_type, std::false_type) {
+            using std::begin;
+            using std::end;
+            auto it = begin(ops);
+            auto last = end(ops);
+            while(it != last) {
+                typename std::decay<decltype(*it)>::type const item = *it;
+                ++it;
+                dumper.cListAttr(ops, "item", item, it == last);
+            }
+        }
+    };
+
+    template <typename... Ts>
+    struct type_list {};
+
+    namespace detail {
+
+        template <typename T, typename List>
+        struct contains;
+
+        template <typename T>
+        struct contains<T, type_list<>> : std::false_type {};
+
+        template <typename T, typename... Ts>
+        struct contains<T, type_list<T, Ts...>> : std::true_type {};
+
+        template <typename T, typename U, typename... Ts>
+        struct contains<T, type_list<U, Ts...>>
+            : contains<T, type_list<Ts...>> {};
+
+        template <typename Dumper, typename = void>
+        struct excluded_types {
+            typedef type_list<> type;
+        };
+
+        template <typename Dumper>
+        struct excluded_types<Dumper,
+                              void_t<typename Dumper::excluded_types>> {
+            typedef typename Dumper::excluded_types type;
+        };
+
+    }
+
+    /**
+     * Whether `Dumper` writes a placeholder instead of dumping attributes,
+     * list items and pointees of type `T`. The call operators for them are
+     * not even instantiated.
+     *
+     * By default the types of a `type_list` named `excluded_types` in the
+     * dumper are excluded:
+     *
+     *     typedef dump::type_list<render_cache, source_buffer>
+     *         excluded_types;
+     *
+     * Specialize it to exclude whole families of types, e.g.
+     *
+     *     template <typename T>
+     *     struct is_excluded<my_dumper, lazy<T>> : std::true_type {};
+     */
+    template <typename Dumper, typename T>
+    struct is_excluded
+        : detail::contains<T, typename detail::excluded_types<Dumper>::type> {};
+
+}
+
+#endif //DUMP_TRAITS_HPP
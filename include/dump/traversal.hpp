@@ -0,0 +1,937 @@
+#ifndef DUMP_TRAVERSAL_HPP
+#define DUMP_TRAVERSAL_HPP
+
+#include "dump/format.hpp"
+#include "dump/path_query.hpp"
+#include "dump/traits.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace dump {
+
+    /**
+     * Type erased reference to a dumped object.
+     */
+    struct object_ref {
+        void const* address;
+        std::type_info const* type;
+
+        template <typename T>
+        explicit object_ref(T const& obj)
+            : address(std::addressof(obj)), type(&typeid(T)) {}
+
+        bool operator==(object_ref const& other) const {
+            return address == other.address && *type == *other.type;
+        }
+    };
+
+    /**
+     * Attribute of a node as passed to `cAttr` and `cListAttr`.
+     */
+    struct attribute {
+        object_ref parent;
+        string_view label;
+        object_ref child;
+        bool last_child;
+        bool inlined;
+
+        /**
+         * Whether the attribute is an item of a list.
+         */
+        bool item;
+    };
+
+    struct render_cache;
+
+    /**
+     * Options of a dump, shared by all dumpers of a policy:
+     *
+     *     my_dumper dumper{std::cout};
+     *     dumper.policy.options.collapse_runs = true;
+     */
+    struct dump_options {
+        /**
+         * Write consecutive items of a list with identical output once,
+         * labelled with the number of repetitions (`item ×4`).
+         */
+        bool collapse_runs = false;
+
+        /**
+         * Cache for the output of subtrees wrapped with `cached`, none if
+         * null.
+         */
+        render_cache* cache = nullptr;
+
+        /**
+         * Maximum bytes of a value, string or block, unlimited if 0. The
+         * middle of longer ones is replaced by `…(N bytes elided)` before
+         * they are escaped and indented.
+         */
+        std::size_t max_value_chars = 0;
+
+        /**
+         * Maximum lines of a value, string or block, unlimited if 0. The
+         * first and last lines of longer ones are kept.
+         */
+        std::size_t max_value_lines = 0;
+    };
+
+    /**
+     * Formatting policy of a `traversal`.
+     *
+     * The traversal decides what is dumped and the policy how it is
+     * written. Policies are not templates, so they are compiled once for
+     * all dumpers (or once into `dump_core`). `enter` and `leave` enclose
+     * the dump of every attribute; every other member writes a token of the
+     * innermost attribute.
+     */
+    struct format_policy {
+        /**
+         * Targets of the pointers followed from the root to the current
+         * attribute.
+         */
+        std::vector<object_ref> pointees;
+
+        dump_options options;
+
+        /**
+         * Restriction of the dump to some attributes, e.g. to the paths of
+         * a query, see `select`.
+         */
+        attribute_filter* selection = nullptr;
+
+        virtual ~format_policy() {}
+
+        /**
+         * Start another dump with the memory of the previous ones, see
+         * `session`.
+         */
+        virtual void start() {
+            pointees.clear();
+        }
+
+        /**
+         * End a dump, e.g. close the environments of LaTeX policies. Their
+         * destructors finish the last dump.
+         */
+        virtual void finish() {
+        }
+
+        /**
+         * Whether `cItems` starts with the size of the list.
+         */
+        virtual bool list_sizes() const {
+            return true;
+        }
+
+        virtual void enter(attribute const& attr) = 0;
+
+        virtual void leave(attribute const& attr) = 0;
+
+        virtual void node(object_ref node, string_view text) = 0;
+
+        virtual void alias(object_ref wrapper, object_ref target) {
+        }
+
+        virtual void type(std::type_info const& info) = 0;
+
+        virtual void addr(void const* address) = 0;
+
+        virtual void type_addr(std::type_info const& info,
+                               void const* address) {
+            type(info);
+            addr(address);
+        }
+
+        virtual void enumeration(string_view text) = 0;
+
+        virtual void value(string_view text) = 0;
+
+        virtual void string(string_view text) {
+            value(text);
+        }
+
+        /**
+         * Numbers, written as `value` by default. Policies which do not
+         * need the text (e.g. `hash_format`) override these.
+         */
+        virtual void integer(long number) {
+            number_buffer buffer;
+            value(format(buffer, number));
+        }
+
+        virtual void unsigned_integer(unsigned long number) {
+            number_buffer buffer;
+            value(format(buffer, number));
+        }
+
+        virtual void real(double number) {
+            number_buffer buffer;
+            value(format(buffer, number));
+        }
+
+        virtual void block(string_view text) = 0;
+
+        /**
+         * Binary data, written as hexdump.
+         */
+        virtual void bytes(unsigned char const* data, std::size_t size) = 0;
+
+        virtual void err(string_view text) = 0;
+
+        virtual void err_type_addr(string_view text,
+                                   std::type_info const& info,
+                                   void const* address) {
+            err(text);
+            type_addr(info, address);
+        }
+
+        virtual void undefined() = 0;
+
+        /**
+         * Whether the output of the current attribute can be cached, see
+         * `render_cache`. `context` is set to everything besides the
+         * dumped object and the policy type the output depends on.
+         */
+        virtual bool cache_context(std::string& context) const {
+            return false;
+        }
+
+        /**
+         * Write the output to `buffer` as if there was no prefix, until
+         * `release` is called. Captures can be nested.
+         */
+        virtual void capture(std::streambuf* buffer) {
+        }
+
+        virtual void release() {
+        }
+
+        /**
+         * Write captured output at the current position.
+         */
+        virtual void splice(string_view text) {
+        }
+    };
+
+    /**
+     * 128 bit hash as computed by `hash_format`.
+     */
+    struct hash128 {
+        std::uint64_t low;
+        std::uint64_t high;
+
+        bool operator==(hash128 const& other) const {
+            return low == other.low && high == other.high;
+        }
+
+        bool operator!=(hash128 const& other) const {
+            return !(*this == other);
+        }
+
+        bool operator<(hash128 const& other) const {
+            return high < other.high
+                || (high == other.high && low < other.low);
+        }
+    };
+
+    /**
+     * 32 lowercase hex digits, e.g. for file names and cache keys.
+     */
+    DUMP_DECL std::string to_string(hash128 const& hash);
+
+    /**
+     * Policy which writes nothing but a structural hash of the dump.
+     *
+     * The hash is computed bottom-up like a Merkle tree: every attribute
+     * is hashed on its own and its label and digest are mixed into the
+     * parent. Integers are hashed in binary, so dumps with the same
+     * output have the same hash without formatting them; floating point
+     * numbers are formatted, since different ones may be written alike.
+     * Addresses are left out so that the hash is stable between runs of
+     * the same build. The hash is not cryptographic.
+     */
+    struct hash_format : format_policy {
+        /**
+         * Number of tasks `hash_dumper` uses for lists with at least
+         * `parallel_items` items.
+         */
+        unsigned threads = 1;
+
+        std::size_t parallel_items = 4096;
+
+        DUMP_DECL hash_format();
+
+        /**
+         * Start a new dump.
+         */
+        DUMP_DECL void reset();
+
+        DUMP_DECL void start() override;
+
+        /**
+         * Hash of the dump since the last `reset`.
+         */
+        DUMP_DECL hash128 digest() const;
+
+        /**
+         * Mix an attribute with the digest of its child into the current
+         * node, as done by `leave`.
+         */
+        DUMP_DECL void child(attribute const& attr, hash128 const& digest);
+
+        DUMP_DECL void enter(attribute const& attr) override;
+
+        DUMP_DECL void leave(attribute const& attr) override;
+
+        DUMP_DECL void node(object_ref node, string_view text) override;
+
+        DUMP_DECL void type(std::type_info const& info) override;
+
+        DUMP_DECL void addr(void const* address) override;
+
+        DUMP_DECL void enumeration(string_view text) override;
+
+        DUMP_DECL void value(string_view text) override;
+
+        DUMP_DECL void string(string_view text) override;
+
+        DUMP_DECL void integer(long number) override;
+
+        DUMP_DECL void unsigned_integer(unsigned long number) override;
+
+        DUMP_DECL void real(double number) override;
+
+        DUMP_DECL void block(string_view text) override;
+
+        DUMP_DECL void bytes(unsigned char const* data,
+                             std::size_t size) override;
+
+        DUMP_DECL void err(string_view text) override;
+
+        DUMP_DECL void undefined() override;
+
+    private:
+        struct state {
+            std::uint64_t h1;
+            std::uint64_t h2;
+            std::uint64_t length;
+
+            DUMP_DECL state();
+
+            DUMP_DECL void mix(std::uint64_t word);
+
+            DUMP_DECL void mix(char token, void const* data,
+                               std::size_t size);
+
+            DUMP_DECL hash128 digest() const;
+        };
+
+        /**
+         * Unfinished hashes of the attributes from the root to the
+         * current one.
+         */
+        std::vector<state> frames;
+
+        void mix(char token, string_view text) {
+            frames.back().mix(token, text.data(), text.size());
+        }
+    };
+
+    /*
+     * Text is dumped like `std::string` and not as a range of characters.
+     */
+    template <>
+    struct traversal_traits<string_view> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, string_view op) {
+            dumper.cString(op);
+        }
+    };
+
+    /**
+     * Contiguous bytes, see `hexdump`.
+     */
+    struct byte_range {
+        unsigned char const* first;
+        std::size_t length;
+
+        unsigned char const* data() const {
+            return first;
+        }
+
+        std::size_t size() const {
+            return length;
+        }
+    };
+
+    /**
+     * Dump the bytes of a contiguous container as hexdump, e.g. a
+     * `small_vector<std::uint8_t, N>` which is otherwise listed byte by byte.
+     */
+    template <typename Container>
+    byte_range hexdump(Container const& ops) {
+        static_assert(sizeof(*ops.data()) == 1,
+                      "hexdumps are only supported for byte containers");
+        return {reinterpret_cast<unsigned char const*>(ops.data()),
+                ops.size()};
+    }
+
+    template <>
+    struct traversal_traits<byte_range>
+        : byte_traversal_traits<byte_range> {};
+
+    /**
+     * Newest items of a container, see `latest`.
+     */
+    template <typename Container>
+    struct latest_items {
+        Container const& container;
+        std::size_t count;
+    };
+
+    /**
+     * Dump only the last `count` items of `ops`, e.g. the newest events of
+     * a `circular_buffer`:
+     *
+     *     this->cAttr(obj, "events", dump::latest(obj.events, 16), true);
+     *
+     * The size is that of the whole container, the number of older items
+     * which are left out is written as `skipped`.
+     */
+    template <typename Container>
+    latest_items<Container> latest(Container const& ops, std::size_t count) {
+        return {ops, count};
+    }
+
+    template <typename Container>
+    struct traversal_traits<latest_items<Container>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, latest_items<Container> const& op) {
+            Container const& ops = op.container;
+            std::size_t const size = ops.size();
+            std::size_t count = op.count < size ? op.count : size;
+            dumper.cAlias(op, ops);
+            if(dumper.policy.list_sizes()) {
+                dumper.cAttr(ops, "size", size, false, true);
+            }
+            dumper.cAttr(ops, "skipped", size - count, count == 0, true);
+            // without visiting the items which are not selected
+            std::size_t first = 0;
+            std::size_t last = count;
+            if(attribute_filter* selection = dumper.policy.selection) {
+                selection->select_items(first, last);
+            }
+            auto it = ops.begin();
+            std::advance(it, size - count + first);
+            for(std::size_t i = first; i < last; ++i, ++it) {
+                dumper.cListAttr(ops, "item", *it, i + 1 == count);
+            }
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * Policy which writes nothing, e.g. for the first pass of `select`.
+         */
+        struct discard_format : format_policy {
+            void enter(attribute const& attr) override {}
+            void leave(attribute const& attr) override {}
+            void node(object_ref node, string_view text) override {}
+            void type(std::type_info const& info) override {}
+            void addr(void const* address) override {}
+            void enumeration(string_view text) override {}
+            void value(string_view text) override {}
+            void integer(long number) override {}
+            void unsigned_integer(unsigned long number) override {}
+            void real(double number) override {}
+            void block(string_view text) override {}
+            void bytes(unsigned char const* data,
+                       std::size_t size) override {}
+            void err(string_view text) override {}
+            void undefined() override {}
+        };
+
+    }
+
+    /**
+     * Object dumped with a `path_query`, see `select`.
+     */
+    template <typename T>
+    struct selected {
+        T const& object;
+        path_query const& query;
+    };
+
+    /**
+     * Only dump the subtrees of `obj` matching `query` and their ancestors,
+     * like `grep` on the full dump but without visiting the rest:
+     *
+     *     dump::path_query const query{"tires/item[2]/width"};
+     *     my_dumper{std::cout}(dump::select(car, query));
+     *
+     * Non-matching attributes of the ancestors, including inlined ones,
+     * are left out. The selection is dumped twice, first without output
+     * to find out which attributes are the last ones with a match, so the
+     * derived dumper has to dump the same attributes both times.
+     */
+    template <typename T>
+    selected<T> select(T const& obj, path_query const& query) {
+        return {obj, query};
+    }
+
+    template <typename T>
+    struct traversal_traits<selected<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, selected<T> const& op) {
+            format_policy& policy = dumper.policy;
+            path_selection selection(op.query);
+            detail::discard_format probe;
+            probe.options = policy.options;
+            probe.options.cache = nullptr;
+            probe.pointees = policy.pointees;
+            probe.selection = &selection;
+            Dumper{probe}.cWrapped(op.object);
+
+            selection.replay();
+            attribute_filter* const outer = policy.selection;
+            policy.selection = &selection;
+            dumper.cAlias(op, op.object);
+            try {
+                dumper.cWrapped(op.object);
+            } catch(...) {
+                policy.selection = outer;
+                throw;
+            }
+            policy.selection = outer;
+        }
+    };
+
+    namespace detail {
+
+        /**
+         * Policy owned by a root dumper. Nested dumpers leave it empty.
+         *
+         * Dumpers inherit from it before `traversal` so that the policy
+         * outlives the traversal.
+         */
+        template <typename Format>
+        struct format_storage {
+            typename std::aligned_storage<sizeof(Format),
+                                          alignof(Format)>::type storage;
+            Format* owned;
+
+            format_storage() : owned(nullptr) {}
+
+            format_storage(format_storage const&) = delete;
+            format_storage& operator=(format_storage const&) = delete;
+
+            ~format_storage() {
+                if(owned) {
+                    owned->~Format();
+                }
+            }
+
+            template <typename... Args>
+            Format& own(Args&&... args) {
+                owned = new(&storage) Format(std::forward<Args>(args)...);
+                return *owned;
+            }
+        };
+
+    }
+
+    /**
+     * Base class for data structure dumpers.
+     *
+     * We use the Curiously recurring template pattern here to be able
+     * to call method's of the derived class. Everything that depends on the
+     * output format is delegated to a `format_policy`, so a dumper that
+     * derives from `traversal` directly is instantiated once and works with
+     * every policy:
+     *
+     *     dump::plaintext_format format{std::cout};
+     *     my_dumper{format}(obj);
+     *
+     * The `plaintext_dumper`, `console_dumper`, `forest_dumper` and
+     * `tikz_dumper` bases additionally own their policy.
+     */
+    template <typename Derived>
+    struct traversal {
+        typedef traversal<Derived> Self;
+
+        format_policy& policy;
+
+        traversal(format_policy& policy)
+            : policy(policy) {}
+
+        Derived &getDerived() {
+            return static_cast<Derived&>(*this);
+        }
+
+        const Derived &getDerived() const {
+            return static_cast<const Derived&>(*this);
+        }
+
+        template <typename Node>
+        void cNode(Node const& node, string_view text) {
+            policy.node(object_ref(node), text);
+        }
+
+        template <typename Dumper, typename Parent, typename Child>
+        void cAttr(Parent const& parent, string_view label,
+                   Child const& child, bool last_child,
+                   bool inlined = false) {
+            attribute attr{object_ref(parent), label, object_ref(child),
+                           last_child, inlined, false};
+            cChild<Dumper>(attr, child);
+        }
+
+        template <typename Parent, typename Child>
+        void cAttr(Parent const& parent, string_view label,
+                   Child const& child, bool last_child,
+                   bool inlined = false) {
+            cAttr<Derived>(parent, label, child, last_child, inlined);
+        }
+
+        template <typename Dumper, typename Parent, typename Child>
+        void cListAttr(Parent const& parent, string_view label,
+                       Child const& child, bool last_child,
+                       bool inlined = false) {
+            attribute attr{object_ref(parent), label, object_ref(child),
+                           last_child, inlined, true};
+            cChild<Dumper>(attr, child);
+        }
+
+        template <typename Parent, typename Child>
+        void cListAttr(Parent const& parent, string_view label,
+                       Child const& child, bool last_child,
+                       bool inlined = false) {
+            cListAttr<Derived>(parent, label, child, last_child, inlined);
+        }
+
+        /**
+         * Dump the child of an attribute, unless it is not selected.
+         */
+        template <typename Dumper, typename Child>
+        void cChild(attribute& attr, Child const& child) {
+            attribute_filter* selection = policy.selection;
+            if(selection && !selection->enter(attr.label, attr.item,
+                                              attr.inlined, attr.last_child)) {
+                return;
+            }
+            policy.enter(attr);
+            cDispatch<Dumper>(policy, child);
+            policy.leave(attr);
+            if(selection) {
+                selection->leave();
+            }
+        }
+
+        /**
+         * Dump `obj` with a new `Dumper`, or write a placeholder if its
+         * type is excluded (see `is_excluded`).
+         */
+        template <typename Dumper, typename T>
+        static void cDispatch(format_policy& policy, T const& obj) {
+            cDispatch<Dumper>(policy, obj, is_excluded<Dumper, T>());
+        }
+
+        template <typename Dumper, typename T>
+        static void cDispatch(format_policy& policy, T const& obj,
+                             std::false_type) {
+            Dumper{policy}(obj);
+        }
+
+        template <typename Dumper, typename T>
+        static void cDispatch(format_policy& policy, T const& obj,
+                             std::true_type) {
+            policy.enumeration("excluded");
+        }
+
+        template <typename Container>
+        void cList(Container const& ops, string_view text) {
+            cNode(ops, text);
+            traversal_traits<Container>::apply(getDerived(), ops);
+        }
+
+        template <typename Container>
+        void cItems(Container const& ops) {
+            auto s = ops.size();
+            if(policy.list_sizes()) {
+                cAttr<Derived>(ops, "size", s, false, true);
+            }
+            // runs are not addressed by selections, so these list items
+            if(policy.selection) {
+                cSelectedItems(ops);
+                return;
+            }
+            if(policy.options.collapse_runs) {
+                cRuns(ops);
+                return;
+            }
+            for(auto const& op : ops) {
+                cListAttr<Derived>(ops, "item", op, --s==0);
+            }
+        }
+
+        /**
+         * List only the items which may match the selection, without
+         * visiting the others.
+         */
+        template <typename Container>
+        void cSelectedItems(Container const& ops) {
+            std::size_t const size = ops.size();
+            std::size_t first = 0;
+            std::size_t last = size;
+            policy.selection->select_items(first, last);
+            auto it = ops.begin();
+            std::advance(it, first);
+            for(std::size_t i = first; i < last; ++i, ++it) {
+                cListAttr<Derived>(ops, "item", *it, i + 1 == size);
+            }
+        }
+
+        /**
+         * List the items of a container, consecutive items with identical
+         * output only once. Every item is dumped into a `hash_format`
+         * first, which is much cheaper than writing it. Items which only
+         * differ in addresses count as identical.
+         */
+        template <typename Container>
+        void cRuns(Container const& ops) {
+            hash_format hash;
+            hash.options = policy.options;
+            hash.pointees = policy.pointees;
+            auto const last = ops.end();
+            auto run = ops.begin();
+            if(run == last) {
+                return;
+            }
+            hash128 run_hash = cHash(hash, *run);
+            std::size_t count = 1;
+            for(auto it = std::next(run); it != last; ++it) {
+                hash128 const item_hash = cHash(hash, *it);
+                if(item_hash == run_hash) {
+                    ++count;
+                } else {
+                    cRun(ops, *run, count, false);
+                    run = it;
+                    run_hash = item_hash;
+                    count = 1;
+                }
+            }
+            cRun(ops, *run, count, true);
+        }
+
+        template <typename Container, typename Item>
+        void cRun(Container const& ops, Item const& item, std::size_t count,
+                  bool last_child) {
+            if(count == 1) {
+                cListAttr<Derived>(ops, "item", item, last_child);
+            } else {
+                number_buffer buffer;
+                std::string label = "item \xc3\x97"; // U+00D7 multiplication sign
+                string_view const& repetitions =
+                    format(buffer, static_cast<unsigned long>(count));
+                label.append(repetitions.data(), repetitions.size());
+                cListAttr<Derived>(ops, label, item, last_child);
+            }
+        }
+
+        template <typename T>
+        hash128 cHash(hash_format& hash, T const& obj) {
+            hash.reset();
+            cDispatch<Derived>(hash, obj);
+            return hash.digest();
+        }
+
+        template <typename Wrapper, typename Target>
+        void cAlias(Wrapper const& wrapper, Target const& target) {
+            policy.alias(object_ref(wrapper), object_ref(target));
+        }
+
+        /**
+         * Dump the target of a pointer. A target which is already being
+         * dumped further up is not entered again but reported as a cycle.
+         */
+        template <typename Pointer, typename Target>
+        void cPointee(Pointer const& pointer, Target const& target) {
+            object_ref const ref(target);
+            cAlias(pointer, target);
+            auto& path = policy.pointees;
+            if(std::find(path.begin(), path.end(), ref) != path.end()) {
+                cErrTypeAddr("cycle", target);
+                return;
+            }
+            path.push_back(ref);
+            cDispatch<Derived>(policy, target);
+            path.pop_back();
+        }
+
+        /**
+         * Dump the target of a wrapper like `optional` with this dumper, or
+         * write a placeholder if its type is excluded (see `is_excluded`).
+         */
+        template <typename T>
+        void cWrapped(T const& target) {
+            cWrapped(target, is_excluded<Derived, T>());
+        }
+
+        template <typename T>
+        void cWrapped(T const& target, std::false_type) {
+            getDerived()(target);
+        }
+
+        template <typename T>
+        void cWrapped(T const& target, std::true_type) {
+            policy.enumeration("excluded");
+        }
+
+        template <typename T>
+        void cAddr(T const& obj) {
+            policy.addr(std::addressof(obj));
+        }
+
+        template <typename T>
+        void cType(T const& obj) {
+            policy.type(typeid(T));
+        }
+
+        template <typename T>
+        void cTypeAddr(T const& obj) {
+            policy.type_addr(typeid(T), std::addressof(obj));
+        }
+
+        void cEnum(string_view text) {
+            policy.enumeration(text);
+        }
+
+        /**
+         * `text` within the value limits of the dump options.
+         */
+        string_view cTruncate(std::string& buffer, string_view text) {
+            return truncate(buffer, text, policy.options.max_value_chars,
+                            policy.options.max_value_lines);
+        }
+
+        void cValue(string_view text) {
+            std::string buffer;
+            policy.value(cTruncate(buffer, text));
+        }
+
+        void cString(string_view text) {
+            std::string buffer;
+            policy.string(cTruncate(buffer, text));
+        }
+
+        void cBlock(string_view text) {
+            std::string buffer;
+            policy.block(cTruncate(buffer, text));
+        }
+
+        void cBytes(void const* data, std::size_t size) {
+            policy.bytes(static_cast<unsigned char const*>(data), size);
+        }
+
+        void cErr(string_view text) {
+            policy.err(text);
+        }
+
+        template <typename T>
+        void cErrTypeAddr(string_view text, T const& obj) {
+            policy.err_type_addr(text, typeid(T), std::addressof(obj));
+        }
+
+        void cUndefined() {
+            policy.undefined();
+        }
+
+        void operator()(bool const& value)
+        {
+            cValue((value ? "true" : "false"));
+        }
+
+        void operator()(char const& value)
+        {
+            policy.integer(value);
+        }
+
+        void operator()(unsigned char const& value)
+        {
+            policy.integer(value);
+        }
+
+        void operator()(short const& value)
+        {
+            policy.integer(value);
+        }
+
+        void operator()(unsigned short const& value)
+        {
+            policy.integer(value);
+        }
+
+        void operator()(int const& value)
+        {
+            policy.integer(value);
+        }
+
+        void operator()(unsigned int const& value)
+        {
+            policy.unsigned_integer(value);
+        }
+
+        void operator()(long const& value)
+        {
+            policy.integer(value);
+        }
+
+        void operator()(unsigned long const& value)
+        {
+            policy.unsigned_integer(value);
+        }
+
+        void operator()(float const& value)
+        {
+            policy.real(value);
+        }
+
+        void operator()(double const& value)
+        {
+            policy.real(value);
+        }
+
+        void operator()(std::string const& value)
+        {
+            cString(value);
+        }
+
+        /**
+         * Containers and third party types, see `traversal_traits`.
+         */
+        template <typename T>
+        void operator()(T const& obj) {
+            traversal_traits<T>::apply(getDerived(), obj);
+        }
+    };
+
+}
+
+#if defined(DUMP_HEADER_ONLY)
+#  include "dump/impl/traversal.ipp"
+#endif
+
+#endif //DUMP_TRAVERSAL_HPP
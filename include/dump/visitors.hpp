@@ -0,0 +1,107 @@
+#ifndef DUMP_VISITORS_HPP
+#define DUMP_VISITORS_HPP
+
+#include "dump/support.hpp"
+#include "dump/x3_support.hpp"
+
+#include <boost/optional.hpp>
+#include <boost/type_index.hpp>
+#include <boost/variant.hpp>
+
+#include <memory>
+#include <string>
+
+namespace dump {
+
+    /*
+     * Visitors which look through the pointer and variant types supported
+     * by the library.
+     */
+
+    struct ptr_visitor {
+        template <typename T>
+        object_address operator()(std::shared_ptr<T> const& obj) {
+            if(obj) {
+                return object_address(*obj);
+            } else {
+                return object_address(obj);
+            }
+        }
+
+        template <typename... _Args>
+        object_address operator()(boost::variant<_Args...> const& obj) {
+            return boost::apply_visitor(*this, obj);
+        }
+
+        template <typename T>
+        object_address operator()(boost::optional<T> const& obj) {
+            if(obj) {
+                return object_address(obj.get());
+            } else {
+                return object_address(obj);
+            }
+        }
+
+        template <typename T,
+              typename std::enable_if<is_variant<T>::value, bool>::type = false>
+        object_address operator()(T const& obj) {
+            return boost::apply_visitor(*this, obj);
+        }
+
+        template <typename T>
+        object_address operator()(boost::spirit::x3::forward_ast<T> const& obj) {
+            return object_address(obj.get());
+        }
+
+        template <typename T,
+              typename std::enable_if<!is_variant<T>::value, bool>::type = false>
+        object_address operator()(T const& obj) const {
+            return object_address(obj);
+        }
+    };
+
+    struct type_id_visitor {
+        template <typename T>
+        std::string operator()(std::shared_ptr<T> const& obj) {
+            if(obj) {
+                return (*this)(*obj);
+            } else {
+                return boost::typeindex::type_id<std::shared_ptr<T>>().pretty_name();
+            }
+        }
+
+        template <typename... _Args>
+        std::string operator()(boost::variant<_Args...> const& obj) {
+            return boost::apply_visitor(*this, obj);
+        }
+
+        template <typename T>
+        std::string operator()(boost::optional<T> const& obj) {
+            if(obj) {
+                return (*this)(obj.get());
+            } else {
+                return boost::typeindex::type_id<boost::optional<T>>().pretty_name();
+            }
+        }
+
+        template <typename T,
+              typename std::enable_if<is_variant<T>::value, bool>::type = false>
+        std::string operator()(T const& ast) {
+            return boost::apply_visitor(*this, ast);
+        }
+
+        template <typename T>
+        std::string operator()(boost::spirit::x3::forward_ast<T> const& ast) {
+            return (*this)(ast.get());
+        }
+
+        template <typename T,
+              typename std::enable_if<!is_variant<T>::value, bool>::type = false>
+        std::string operator()(T const& obj) const {
+            return boost::typeindex::type_id<T>().pretty_name();
+        }
+    };
+
+}
+
+#endif //DUMP_VISITORS_HPP
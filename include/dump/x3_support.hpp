@@ -1,6 +1,9 @@
 #ifndef DUMP_X3_SUPPORT_HPP
 #define DUMP_X3_SUPPORT_HPP
 
+#include "dump/boost_support.hpp"
+#include "dump/traits.hpp"
+
 #include <boost/spirit/home/x3/support/ast/variant.hpp>
 
 #include <type_traits>
@@ -33,6 +36,29 @@ namespace dump {
     template <typename T, typename ...Ts>
     struct is_variant<T, pack<Ts...>> : std::true_type {};
 
+    /*
+     * Boost Spirit X3 variant type and types derived from it
+     */
+    template <typename T>
+    struct traversal_traits<T,
+              typename std::enable_if<is_variant<T>::value>::type> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper, T const& ast) {
+            variant_visitor<Dumper, T> visitor{dumper, ast};
+            boost::apply_visitor(visitor, ast);
+        }
+    };
+
+    template <typename T>
+    struct traversal_traits<boost::spirit::x3::forward_ast<T>> {
+        template <typename Dumper>
+        static void apply(Dumper& dumper,
+                          boost::spirit::x3::forward_ast<T> const& ast) {
+            dumper.cAlias(ast, ast.get());
+            dumper.cWrapped(ast.get());
+        }
+    };
+
 }
 
 #endif //DUMP_X3_SUPPORT_HPP
@@ -0,0 +1,26 @@
+/*
+ * Non-template parts of the library for the `dump_core` target.
+ */
+
+#if !defined(DUMP_SEPARATE_COMPILATION)
+#  error "dump_core has to be compiled with DUMP_SEPARATE_COMPILATION"
+#endif
+
+#include "dump/impl/compressed.ipp"
+#include "dump/impl/console.ipp"
+#include "dump/impl/explorer.ipp"
+#include "dump/impl/filesystem.ipp"
+#include "dump/impl/forest.ipp"
+#include "dump/impl/format.ipp"
+#include "dump/impl/html.ipp"
+#include "dump/impl/latex_build.ipp"
+#include "dump/impl/latex_support.ipp"
+#include "dump/impl/layout.ipp"
+#include "dump/impl/path_query.ipp"
+#include "dump/impl/plaintext.ipp"
+#include "dump/impl/render_cache.ipp"
+#include "dump/impl/summary.ipp"
+#include "dump/impl/support.ipp"
+#include "dump/impl/svg.ipp"
+#include "dump/impl/tikz.ipp"
+#include "dump/impl/traversal.ipp"
@@ -0,0 +1,47 @@
+#ifndef DUMP_ALLOC_COUNTER_HPP
+#define DUMP_ALLOC_COUNTER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+namespace dump { namespace alloc {
+
+    /**
+     * Number of heap allocations made by the process so far.
+     *
+     * Counted by the global `operator new` and, where the C library allows
+     * it, `malloc` replacements of the `allocTest` target.
+     */
+    std::size_t allocations();
+
+    template <typename F>
+    std::size_t count_allocations(F&& f) {
+        std::size_t before = allocations();
+        f();
+        return allocations() - before;
+    }
+
+    /**
+     * Stream buffer which discards everything without ever allocating so
+     * that only the allocations of the dumpers are counted.
+     */
+    struct null_buffer : std::streambuf {
+        int_type overflow(int_type c) override {
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(char const*, std::streamsize n) override {
+            return n;
+        }
+    };
+
+    struct null_stream : std::ostream {
+        null_buffer buffer;
+
+        null_stream() : std::ostream(&buffer) {}
+    };
+
+}}
+
+#endif //DUMP_ALLOC_COUNTER_HPP
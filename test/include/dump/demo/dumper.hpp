@@ -2,6 +2,7 @@
 #define DUMP_DEMO_DUMPER_HPP
 
 #include "dump/demo/car.hpp"
+#include "dump/std_support.hpp"
 
 namespace dump { namespace dispatch {
     struct full;
@@ -0,0 +1,131 @@
+#include "dump/console.hpp"
+#include "dump/forest.hpp"
+#include "dump/plaintext.hpp"
+#include "dump/session.hpp"
+#include "dump/tikz.hpp"
+#include "dump/alloc/counter.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    namespace {
+
+        demo::cars make_cars(std::size_t n) {
+            demo::tire t{"Tire Brand", 215, 16};
+            demo::cars cs;
+            for(std::size_t i = 0; i < n; ++i) {
+                cs.emplace_back("Car Brand", "Model 2000",
+                                static_cast<unsigned>(1990 + i % 30),
+                                demo::engine{demo::fuel_type::electric,
+                                             69.f + i},
+                                demo::four_tires{{t, t, t, t}});
+            }
+            return cs;
+        }
+
+        std::vector<int> make_ints(std::size_t n) {
+            std::vector<int> is;
+            for(std::size_t i = 0; i < n; ++i) {
+                is.push_back(static_cast<int>(i * 7919));
+            }
+            return is;
+        }
+
+        std::vector<std::vector<double>> make_rows(std::size_t n) {
+            return std::vector<std::vector<double>>(
+                n, std::vector<double>{1e-3, 1.5, 1e12});
+        }
+
+        /*
+         * Allocations of a warmed up dump of `obj`.
+         */
+        template <template <typename> class Base, typename T>
+        std::size_t dump_allocations(T const& obj) {
+            alloc::null_stream out;
+            demo::dumper<Base>{out}(obj);
+            return alloc::count_allocations([&] {
+                demo::dumper<Base>{out}(obj);
+            });
+        }
+
+        /*
+         * Allocations per element of the structures built by `make`.
+         *
+         * The difference between a structure of `2n` and `n` elements
+         * cancels everything that is allocated once per dump.
+         */
+        template <template <typename> class Base, typename Make>
+        double per_element(Make make, std::size_t n) {
+            auto const& small = make(n);
+            auto const& large = make(2 * n);
+            double a = dump_allocations<Base>(small);
+            double b = dump_allocations<Base>(large);
+            return (b - a) / n;
+        }
+
+
+        /*
+         * Allocations of a dump of `obj` with a warmed up session.
+         */
+        template <typename Format, typename Dumper, typename T>
+        std::size_t session_allocations(T const& obj) {
+            alloc::null_stream out;
+            session<Format> s;
+            s.template dump<Dumper>(out, obj);
+            return alloc::count_allocations([&] {
+                s.template dump<Dumper>(out, obj);
+            });
+        }
+
+    }
+
+    TEST_CASE( "Sessions allocate nothing", "[alloc]" ) {
+        auto const& cars = make_cars(64);
+        CHECK( session_allocations<plaintext_format,
+                                   demo::dumper<plaintext_dumper>>(cars)
+               == 0 );
+        CHECK( session_allocations<console_format,
+                                   demo::dumper<console_dumper>>(cars)
+               == 0 );
+        CHECK( session_allocations<forest_format,
+                                   demo::dumper<forest_dumper>>(cars)
+               == 0 );
+        CHECK( session_allocations<plaintext_format,
+                                   demo::dumper<plaintext_dumper>>(
+                                       make_rows(64)) == 0 );
+    }
+
+    TEST_CASE( "Allocation budget of plaintext", "[alloc]" ) {
+        CHECK( per_element<plaintext_dumper>(make_ints, 256) == 0 );
+        CHECK( per_element<plaintext_dumper>(make_rows, 64) == 0 );
+        CHECK( per_element<plaintext_dumper>(make_cars, 64) == 0 );
+    }
+
+    TEST_CASE( "Allocation budget of console", "[alloc]" ) {
+        CHECK( per_element<console_dumper>(make_ints, 256) == 0 );
+        CHECK( per_element<console_dumper>(make_rows, 64) == 0 );
+        CHECK( per_element<console_dumper>(make_cars, 64) == 0 );
+    }
+
+    TEST_CASE( "Allocation budget of forest", "[alloc]" ) {
+        CHECK( per_element<forest_dumper>(make_ints, 256) == 0 );
+        CHECK( per_element<forest_dumper>(make_rows, 64) == 0 );
+        CHECK( per_element<forest_dumper>(make_cars, 64) == 0 );
+    }
+
+    /*
+     * The tikz_format still buffers every node in its own streams and keeps
+     * the visited nodes and aliases in node based containers. These budgets
+     * are the current ceiling and must only ever go down.
+     */
+    TEST_CASE( "Allocation budget of tikz", "[alloc]" ) {
+        CHECK( per_element<tikz_dumper>(make_ints, 256) <= 1.5 );
+        CHECK( per_element<tikz_dumper>(make_rows, 64) <= 9.5 );
+        CHECK( per_element<tikz_dumper>(make_cars, 64) <= 276 );
+    }
+
+}
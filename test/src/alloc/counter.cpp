@@ -0,0 +1,93 @@
+#include "dump/alloc/counter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<std::size_t> counter{0};
+}
+
+#if defined(__GLIBC__)
+/*
+ * Count the C allocations as well. The replacements forward to the glibc
+ * implementations which keeps `free` compatible with every allocation.
+ */
+extern "C" {
+    void* __libc_malloc(std::size_t size);
+    void* __libc_calloc(std::size_t count, std::size_t size);
+    void* __libc_realloc(void* ptr, std::size_t size);
+
+    void* malloc(std::size_t size) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return __libc_malloc(size);
+    }
+
+    void* calloc(std::size_t count, std::size_t size) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, std::size_t size) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return __libc_realloc(ptr, size);
+    }
+}
+
+namespace {
+    void* allocate(std::size_t size) {
+        // `malloc` counts already
+        return std::malloc(size == 0 ? 1 : size);
+    }
+}
+#else
+namespace {
+    void* allocate(std::size_t size) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+}
+#endif
+
+void* operator new(std::size_t size) {
+    if(void* ptr = allocate(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+    return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace dump { namespace alloc {
+
+    std::size_t allocations() {
+        return counter.load(std::memory_order_relaxed);
+    }
+
+}}
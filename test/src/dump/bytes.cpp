@@ -0,0 +1,88 @@
+#include "dump/plaintext.hpp"
+#include "dump/std_support.hpp"
+#include "dump/tikz.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <array>
+#include <bitset>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    TEST_CASE( "Hexdump of byte buffers for plaintext", "[dumper]" ) {
+        auto dump = [](auto const& obj) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper>{oss}(obj);
+            return oss.str();
+        };
+
+        std::vector<unsigned char> buffer;
+        for(int i = 0; i < 20; ++i) {
+            buffer.push_back(static_cast<unsigned char>(i * 13 + 32));
+        }
+        CHECK( dump(buffer) ==
+               " size '20'\n"
+               "`- 00000000  20 2d 3a 47 54 61 6e 7b  88 95 a2 af bc c9 d6 e3"
+               "  | -:GTan{........|\n"
+               "  00000010  f0 fd 0a 17                                   "
+               "    |....|" );
+
+        std::array<char, 3> text{{'a', '\0', 'z'}};
+        CHECK( dump(text) ==
+               " size '3'\n"
+               "`- 00000000  61 00 7a                                      "
+               "    |a.z|" );
+
+        CHECK( dump(std::vector<char>()) == " size '0'" );
+    }
+
+    TEST_CASE( "Hex encoding matches the scalar encoder", "[format]" ) {
+        std::vector<unsigned char> data;
+        for(int i = 0; i < 256 + 7; ++i) {
+            data.push_back(static_cast<unsigned char>(i));
+        }
+        std::string hex(2 * data.size(), ' ');
+        hex_encode(&hex[0], data.data(), data.size());
+        std::string expected;
+        for(unsigned char byte : data) {
+            expected += "0123456789abcdef"[byte >> 4];
+            expected += "0123456789abcdef"[byte & 0x0f];
+        }
+        CHECK( hex == expected );
+    }
+
+    TEST_CASE( "Bitsets as packed bits for plaintext", "[dumper]" ) {
+        auto dump = [](auto const& obj) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper>{oss}(obj);
+            return oss.str();
+        };
+
+        CHECK( dump(std::bitset<12>(0x805)) ==
+               " size '12' count '3' bits '10000000 0101'" );
+
+        std::vector<bool> flags(70, false);
+        flags[0] = flags[69] = true;
+        CHECK( dump(flags) ==
+               " size '70' count '2'\n"
+               "`- bits 10000000 00000000 00000000 00000000"
+               " 00000000 00000000 00000000 00000000\n"
+               "        000001" );
+    }
+
+    TEST_CASE( "Hexdump of byte buffers for tikz", "[dumper]" ) {
+        std::vector<char> buffer{'{', '%', ' ', '\\'};
+        std::ostringstream bytes;
+        {
+            demo::dumper<tikz_dumper>{bytes}(buffer);
+        }
+        CHECK( bytes.str().find(
+                   "\\shortstack[l]{\\texttt{00000000~~7b~25~20~5c") !=
+               std::string::npos );
+        CHECK( bytes.str().find("|..~.|}") != std::string::npos );
+    }
+
+}
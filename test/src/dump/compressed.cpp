@@ -0,0 +1,91 @@
+#include "dump/compressed.hpp"
+#include "dump/filesystem.hpp"
+#include "dump/plaintext.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filter/zstd.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace dump {
+
+    namespace {
+
+        std::string decompress(std::string const& data, compression codec) {
+            namespace io = boost::iostreams;
+            std::istringstream in(data);
+            io::filtering_istream filter;
+            if(codec == gzip) {
+                filter.push(io::gzip_decompressor());
+            } else {
+                filter.push(io::zstd_decompressor());
+            }
+            filter.push(in);
+            std::ostringstream out;
+            io::copy(filter, out);
+            return out.str();
+        }
+
+    }
+
+    TEST_CASE( "Compressed output for plaintext", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        std::ostringstream plain;
+        for(int i = 0; i < 2000; ++i) {
+            demo::dumper<plaintext_dumper>{plain}(c);
+        }
+
+        for(compression codec : {gzip, zstd}) {
+            std::ostringstream sink;
+            {
+                compressed_ostream out{sink, codec};
+                for(int i = 0; i < 2000; ++i) {
+                    demo::dumper<plaintext_dumper>{out}(c);
+                }
+            }
+            CHECK( sink.str().size() < plain.str().size() / 20 );
+            CHECK( decompress(sink.str(), codec) == plain.str() );
+        }
+
+        std::ostringstream sink;
+        compressed_ostream empty{sink, gzip};
+        empty.close();
+        CHECK( decompress(sink.str(), gzip).empty() );
+    }
+
+    TEST_CASE( "Compressed files of fs", "[fs]" ) {
+        namespace fs = boost::filesystem;
+        fs::path const directory =
+            fs::temp_directory_path() / fs::unique_path("dump-%%%%-%%%%");
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        fs_options options;
+        options.formats = fs_plaintext;
+        options.directory = directory.string();
+        options.codec = zstd;
+        fs::create_directories(directory);
+        ::dump::fs<demo::dumper>("p", "car", "t", c, options);
+
+        std::ifstream in(fs_path(options.directory, "p", "car", "t",
+                                 ".txt.zst"), std::ios::binary);
+        std::ostringstream data;
+        data << in.rdbuf();
+        std::ostringstream expected;
+        demo::dumper<plaintext_dumper>{expected}(c);
+        expected << std::endl;
+        CHECK( decompress(data.str(), zstd) == expected.str() );
+
+        fs::remove_all(directory);
+    }
+
+}
@@ -0,0 +1,133 @@
+#include "dump/explorer.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    namespace {
+
+        /*
+         * Rows of the last screen without escape codes
+         */
+        std::vector<std::string> last_screen(std::string const& output) {
+            std::string const screen =
+                output.substr(output.rfind("\x1B[H\x1B[2J") + 7);
+            std::vector<std::string> rows;
+            std::string row;
+            for(std::size_t i = 0; i < screen.size(); ++i) {
+                if(screen[i] == '\x1B') {
+                    i = screen.find('m', i);
+                } else if(screen[i] == '\n') {
+                    rows.push_back(row);
+                    row.clear();
+                } else {
+                    row += screen[i];
+                }
+            }
+            return rows;
+        }
+
+        struct tree {
+            std::vector<tree> children;
+        };
+
+        /*
+         * Counts the visited nodes
+         */
+        struct tree_dumper : console_dumper<tree_dumper> {
+            using console_dumper<tree_dumper>::console_dumper;
+            using console_dumper<tree_dumper>::operator();
+
+            static std::size_t visits;
+
+            void operator()(tree const& obj) {
+                ++visits;
+                cNode(obj, "Tree");
+                cAttr(obj, "children", obj.children, true);
+            }
+        };
+
+        std::size_t tree_dumper::visits = 0;
+
+        struct latest_dumper : console_dumper<latest_dumper> {
+            using console_dumper<latest_dumper>::console_dumper;
+            using console_dumper<latest_dumper>::operator();
+
+            void operator()(tree const& obj) {
+                ++tree_dumper::visits;
+                cNode(obj, "Tree");
+                cAttr(obj, "children", latest(obj.children, 500), true);
+            }
+        };
+
+    }
+
+    TEST_CASE( "Explorer expands nodes on key press", "[explorer]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+
+        std::istringstream none{"q"};
+        std::ostringstream first;
+        explore<demo::dumper<console_dumper>>(c, none, first);
+        CHECK( last_screen(first.str()) == std::vector<std::string>{
+            ">   Car manufacturer 'Car Brand' model 'Model 2000' "
+            "year '2002'",
+            "    |- main engine Engine fuel electric power '69.000000'",
+            "  + `- tires Tires size '4'"} );
+
+        // down twice, expand the tires, select the second one, go back up
+        std::istringstream keys{"jjl\x1B[B\x1B[Bh"};
+        std::ostringstream expanded;
+        explore<demo::dumper<console_dumper>>(c, keys, expanded);
+        std::vector<std::string> const& rows = last_screen(expanded.str());
+        REQUIRE( rows.size() == 7 );
+        CHECK( rows[2] == "> - `- tires Tires size '4'" );
+        CHECK( rows[4] == "      |- item Tire manufacturer 'Tire Brand' "
+                          "width '215' size '16.000000'" );
+        CHECK( expanded.str().rfind("j/k move") != std::string::npos );
+    }
+
+    TEST_CASE( "Explorer visits only what is visible", "[explorer]" ) {
+        tree root;
+        root.children.resize(1000);
+        for(tree& child : root.children) {
+            child.children.resize(100);
+        }
+
+        explorer_options options;
+        options.page = 10;
+        options.height = 8;
+        tree_dumper::visits = 0;
+        std::istringstream keys{"jl]]jl"};
+        std::ostringstream out;
+        explore<tree_dumper>(root, keys, out, options);
+        // at most root, one page and another page per screen
+        CHECK( tree_dumper::visits <= 7 * (1 + 10 + 10) );
+
+        std::vector<std::string> const& rows = last_screen(out.str());
+        REQUIRE( rows.size() == 7 );
+        CHECK( rows[1] == "  - `- children  size '1000' "
+                          "[items 21-30 of 1000]" );
+        CHECK( rows[2] == "> -   |- item Tree" );
+        CHECK( rows[3] == "  +   | `- children  size '100'" );
+
+        // newest items as well
+        tree_dumper::visits = 0;
+        std::istringstream latest_keys{"jl]]jl"};
+        std::ostringstream latest_out;
+        explore<latest_dumper>(root, latest_keys, latest_out, options);
+        CHECK( tree_dumper::visits <= 7 * (1 + 10 + 10) );
+        std::vector<std::string> const& latest_rows =
+            last_screen(latest_out.str());
+        REQUIRE( latest_rows.size() == 7 );
+        CHECK( latest_rows[1] == "  - `- children  size '1000' "
+                                 "skipped '500' [items 21-30 of 500]" );
+    }
+
+}
@@ -0,0 +1,86 @@
+#include "dump/filesystem.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+namespace dump {
+
+    TEST_CASE( "Selected formats written only when changed", "[fs]" ) {
+        namespace fs = boost::filesystem;
+        fs::path const directory =
+            fs::temp_directory_path() / fs::unique_path("dump-%%%%-%%%%");
+        fs::create_directories(directory);
+        auto const path = [&directory](char const* extension) {
+            return fs_path(directory.string(), "p", "car", "t", extension);
+        };
+
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        fs_options options;
+        options.formats = fs_plaintext | fs_forest;
+        options.directory = directory.string();
+        options.parallel = true;
+        ::dump::fs<demo::dumper>("p", "car", "t", c, options);
+
+        CHECK( !fs::exists(path(".ansi")) );
+        CHECK( !fs::exists(path(".tikz.tex")) );
+        std::ostringstream expected;
+        demo::dumper<plaintext_dumper>{expected}(c);
+        expected << std::endl;
+        std::ifstream in(path(".txt"));
+        std::stringstream written;
+        written << in.rdbuf();
+        CHECK( written.str() == expected.str() );
+
+        // unchanged files keep their modification time
+        std::time_t const old = fs::last_write_time(path(".txt")) - 100;
+        fs::last_write_time(path(".txt"), old);
+        fs::last_write_time(path(".forest.tex"), old);
+        ::dump::fs<demo::dumper>("p", "car", "t", c, options);
+        CHECK( fs::last_write_time(path(".txt")) == old );
+        CHECK( fs::last_write_time(path(".forest.tex")) == old );
+
+        c.year = 2003;
+        options.parallel = false;
+        ::dump::fs<demo::dumper>("p", "car", "t", c, options);
+        CHECK( fs::last_write_time(path(".txt")) != old );
+
+        CHECK( fs_write(path(".txt"), "x") );
+        CHECK( !fs_write(path(".txt"), "x") );
+        CHECK( fs_write(path(".txt"), "y") );
+        fs::remove(path(".txt"));
+        CHECK( fs_write(path(".txt"), "y") );
+        CHECK( std::distance(fs::directory_iterator(directory),
+                             fs::directory_iterator()) == 2 );
+
+        // a failed write leaves no temporary file behind
+        fs::create_directories(path(".dir") + "/occupied");
+        CHECK_THROWS( fs_write(path(".dir"), "z") );
+        CHECK( std::distance(fs::directory_iterator(directory),
+                             fs::directory_iterator()) == 3 );
+
+        // and neither does an output which is not committed
+        {
+            fs_output out(path(".out"));
+            out.stream() << "z";
+        }
+        CHECK( !fs::exists(path(".out")) );
+        {
+            fs_output out(path(".txt"));
+            out.stream() << "y";
+            CHECK( !out.commit() );
+        }
+        CHECK( std::distance(fs::directory_iterator(directory),
+                             fs::directory_iterator()) == 3 );
+
+        fs::remove_all(directory);
+    }
+
+}
@@ -4,6 +4,7 @@
 #include "test.hpp"
 
 #include <fstream>
+#include <sstream>
 
 namespace dump {
 
@@ -27,4 +28,87 @@ namespace dump {
         CHECK( true );
     }
 
+    TEST_CASE( "Split forest environments", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        auto dump = [&c](forest_split split) {
+            std::ostringstream oss;
+            demo::dumper<forest_dumper>{oss, split}(c);
+            return oss.str();
+        };
+
+        std::ostringstream full;
+        demo::dumper<forest_dumper>{full}(c);
+        CHECK( dump(forest_split()) == full.str() );
+
+        auto count = [](std::string const& text, std::string const& part) {
+            std::size_t n = 0;
+            for(std::size_t i = text.find(part); i != std::string::npos;
+                i = text.find(part, i + 1)) {
+                ++n;
+            }
+            return n;
+        };
+
+        // the last three tires continue in a second environment
+        forest_split by_nodes;
+        by_nodes.max_nodes = 4;
+        std::string const& nodes = dump(by_nodes);
+        CHECK( count(nodes, "\\begin{forest}") == 2 );
+        CHECK( count(nodes, "\\end{forest}") == 2 );
+        CHECK( count(nodes, "[item ") == 4 );
+        CHECK( nodes.find("  [\\hyperlink{dump-forest-1}{$\\rightarrow$~1}]\n"
+                          "]\n]\n\\end{forest}\n"
+                          "\\begin{forest}") != std::string::npos );
+        CHECK( nodes.find("[\\hypertarget{dump-forest-1}{}"
+                          "\\hyperlink{dump-forest-0}{$\\leftarrow$~1} tires\n"
+                          " [item ") != std::string::npos );
+
+        // one tire per environment
+        by_nodes.max_nodes = 2;
+        std::string const& chain = dump(by_nodes);
+        CHECK( count(chain, "\\begin{forest}") == 6 );
+        CHECK( count(chain, "\\end{forest}") == 6 );
+        CHECK( count(chain, "\\hypertarget") == 6 );
+        CHECK( count(chain, "$\\rightarrow$") == 5 );
+
+        // all tires continue in a second environment
+        forest_split by_depth;
+        by_depth.max_depth = 1;
+        std::string const& depth = dump(by_depth);
+        CHECK( count(depth, "\\begin{forest}") == 2 );
+        CHECK( depth.find("size \\textcolor{green}{ 4 }   "
+                          "[\\hyperlink{dump-forest-1}") != std::string::npos );
+        CHECK( count(depth.substr(depth.find("dump-forest-1}{}")),
+                     "[item ") == 4 );
+    }
+
+    TEST_CASE( "Forest with a precomputed layout", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+
+        std::ostringstream oss;
+        demo::dumper<forest_dumper>{oss, forest_layout()}(c);
+        std::string const& out = oss.str();
+        CHECK( out.find("\\begin{forest}") == std::string::npos );
+        CHECK( out.find("\\begin{tikzpicture}") == 0 );
+        // a row of 12pt, 6.67pt inner sep and 6pt spacing per node, the
+        // tires below the engine
+        CHECK( out.find("\\node (dump-forest-0) at (0.00pt,0.00pt) "
+                        "{\\textbf{\\textcolor{magenta}{Car}}")
+               != std::string::npos );
+        CHECK( out.find("\\node (dump-forest-2) at (15.00pt,-49.34pt) "
+                        "{tires ")
+               != std::string::npos );
+        CHECK( out.find("\\node (dump-forest-6) at (30.00pt,-148.02pt)")
+               != std::string::npos );
+        CHECK( out.find("\\draw ([xshift=7.5pt]dump-forest-2.south west) |-"
+                        " node[fill, inner sep=1.25pt, anchor=center] {}"
+                        " (dump-forest-6.west);\n")
+               != std::string::npos );
+        CHECK( out.substr(out.size() - 18) == "\\end{tikzpicture}\n" );
+    }
+
 }
@@ -0,0 +1,78 @@
+#include "dump/hash.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <climits>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    TEST_CASE( "Structural hashes", "[dumper]" ) {
+        auto hash = [](auto const& obj) {
+            hash128 result;
+            demo::dumper<hash_dumper>{result}(obj);
+            return result;
+        };
+
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        demo::car copy = c;
+        CHECK( hash(c) == hash(copy) );
+        CHECK( to_string(hash(c)).size() == 32 );
+
+        copy.tires[3].width = 225;
+        CHECK( hash(c) != hash(copy) );
+        copy = c;
+        copy.model = "Model 2001";
+        CHECK( hash(c) != hash(copy) );
+
+        // the same values in other attributes
+        CHECK( hash(std::vector<int>{1, 2}) != hash(std::vector<int>{2, 1}) );
+        CHECK( hash(std::vector<std::string>{"ab", "c"}) !=
+               hash(std::vector<std::string>{"a", "bc"}) );
+
+        // numbers hash like they are written
+        CHECK( hash(std::vector<int>{7}) == hash(std::vector<long>{7}) );
+        CHECK( hash(std::vector<float>{0.5f}) ==
+               hash(std::vector<double>{0.5}) );
+        CHECK( hash(std::vector<unsigned long>{5}) ==
+               hash(std::vector<long>{5}) );
+        CHECK( hash(std::vector<unsigned long>{ULONG_MAX}) !=
+               hash(std::vector<long>{-1}) );
+
+        // dispatch tags still select the operators
+        hash128 sparse;
+        demo::dumper<hash_dumper, dispatch::sparse>{sparse}(c);
+        CHECK( sparse != hash(c) );
+    }
+
+    TEST_CASE( "Parallel structural hashes", "[dumper]" ) {
+        std::vector<std::vector<int>> rows;
+        for(int i = 0; i < 100; ++i) {
+            rows.emplace_back(i % 7, i);
+        }
+
+        hash_format sequential;
+        sequential.threads = 1;
+        demo::dumper<hash_dumper>{sequential}(rows);
+
+        hash_format parallel;
+        parallel.threads = 4;
+        parallel.parallel_items = 2;
+        demo::dumper<hash_dumper>{parallel}(rows);
+
+        CHECK( parallel.digest() == sequential.digest() );
+
+        // selections are hashed on one thread
+        path_query const query{"item[3]/item[1]"};
+        sequential.reset();
+        demo::dumper<hash_dumper>{sequential}(select(rows, query));
+        parallel.reset();
+        demo::dumper<hash_dumper>{parallel}(select(rows, query));
+        CHECK( parallel.digest() == sequential.digest() );
+        CHECK( parallel.digest() != hash_format().digest() );
+    }
+
+}
@@ -0,0 +1,126 @@
+#include "dump/html.hpp"
+#include "dump/session.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include <cstddef>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    namespace {
+
+        /*
+         * Content of the chunks by id
+         */
+        std::map<std::string, std::string> chunks(std::string const& page) {
+            std::string const open = "<script type=\"application/x-dump-chunk\""
+                                     " id=\"dump-";
+            std::map<std::string, std::string> found;
+            std::size_t at = 0;
+            while((at = page.find(open, at)) != std::string::npos) {
+                at += open.size();
+                std::size_t const id_end = page.find('"', at);
+                std::size_t const begin = page.find('>', id_end) + 1;
+                std::size_t const end = page.find("</script>", begin);
+                found[page.substr(at, id_end - at)] =
+                    page.substr(begin, end - begin);
+                at = end;
+            }
+            return found;
+        }
+
+        std::string gunzip_base64(std::string const& text) {
+            std::string data;
+            unsigned long bits = 0;
+            int count = 0;
+            for(char c : text) {
+                std::string const digits =
+                    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+                    "0123456789+/";
+                std::size_t const digit = digits.find(c);
+                if(digit == std::string::npos) {
+                    break;
+                }
+                bits = bits << 6 | digit;
+                count += 6;
+                if(count >= 8) {
+                    count -= 8;
+                    data += static_cast<char>(bits >> count & 0xff);
+                }
+            }
+            namespace io = boost::iostreams;
+            std::istringstream in(data);
+            io::filtering_istream filter;
+            filter.push(io::gzip_decompressor());
+            filter.push(in);
+            std::ostringstream out;
+            io::copy(filter, out);
+            return out.str();
+        }
+
+    }
+
+    TEST_CASE( "HTML page with chunks", "[dumper]" ) {
+        demo::tire t{"Tire <Brand>", 215, 16};
+        demo::car c{"Car \"Brand\"", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+
+        html_options options;
+        options.compress = false;
+        std::ostringstream single;
+        demo::dumper<html_dumper>{single, options}(c);
+        std::string const& document = single.str();
+        CHECK( document.find("<!DOCTYPE html>") == 0 );
+        CHECK( document.substr(document.size() - 8) == "</html>\n" );
+        auto const& one = chunks(document);
+        REQUIRE( one.size() == 1 );
+        CHECK( one.at("0").find(
+                   "[{\"h\":\"<span class=n>Car</span> <span class=l>"
+                   "manufacturer</span> <span class=v>Car &quot;Brand&quot;"
+                   "</span>") == 0 );
+        CHECK( one.at("0").find("Tire &lt;Brand&gt;") != std::string::npos );
+
+        // tires in chunks of their own, the list in pages of 100 cars
+        std::vector<demo::car> cars(250, c);
+        options.chunk_depth = 2;
+        options.chunk_children = 100;
+        std::ostringstream plain;
+        demo::dumper<html_dumper>{plain, options}(cars);
+        auto const& json = chunks(plain.str());
+        CHECK( json.size() == 1 + 250 + 2 );
+        CHECK( plain.str().rfind("id=\"dump-0\"")
+               > plain.str().rfind("id=\"dump-1\"") );
+        std::string const& root = json.at("0");
+        CHECK( root.find("\"c\":[{\"k\":1}]}") != std::string::npos );
+        std::string const& root_end = ",{\"k\":101,\"m\":1}]}]";
+        CHECK( root.substr(root.size() - root_end.size()) == root_end );
+        std::string const& page_end = ",{\"k\":202,\"m\":1}]";
+        std::string const& page = json.at("101");
+        CHECK( page.substr(page.size() - page_end.size()) == page_end );
+
+        options.compress = true;
+        std::ostringstream compressed;
+        demo::dumper<html_dumper>{compressed, options}(cars);
+        auto const& gzip = chunks(compressed.str());
+        REQUIRE( gzip.size() == json.size() );
+        CHECK( gunzip_base64(gzip.at("0")) == root );
+        CHECK( gunzip_base64(gzip.at("202")) == json.at("202") );
+        CHECK( compressed.str().size() < plain.str().size() / 3 );
+
+        session<html_format> s{options};
+        for(int i = 0; i < 2; ++i) {
+            std::ostringstream out;
+            s.dump<demo::dumper<html_dumper>>(out, cars);
+            CHECK( out.str() == compressed.str() );
+        }
+    }
+
+}
@@ -0,0 +1,64 @@
+#include "dump/latex_build.hpp"
+#include "test.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    TEST_CASE( "LaTeX build with cached PDFs", "[latex]" ) {
+        namespace fs = boost::filesystem;
+        fs::path const directory =
+            fs::temp_directory_path() / fs::unique_path("dump-%%%%-%%%%");
+        fs::create_directories(directory);
+        auto const write = [&directory](char const* name, char const* text) {
+            std::ofstream((directory / name).string()) << text;
+            return (directory / name).string();
+        };
+
+        latex_build_options options;
+        // "compiles" by copying the source
+        options.command = "sh -c 'cp \"$1\" \"${1%.tex}.pdf\"' sh";
+        options.cache = (directory / "cache").string();
+        options.jobs = 2;
+        std::vector<std::string> const sources = {
+            write("a.tikz.tex", "a"),
+            write("b.forest.tex", "b"),
+            write("c's.tex", "c")
+        };
+
+        std::vector<latex_build_result> results = latex_build(sources, options);
+        REQUIRE( results.size() == 3 );
+        for(latex_build_result const& result : results) {
+            CHECK( result.status == 0 );
+            CHECK( !result.cached );
+        }
+        CHECK( results[0].pdf == (directory / "a.tikz.pdf").string() );
+        CHECK( fs::exists(directory / "c's.pdf") );
+
+        // only the changed source is compiled again
+        fs::remove(directory / "a.tikz.pdf");
+        write("b.forest.tex", "changed");
+        results = latex_build(sources, options);
+        CHECK( results[0].cached );
+        CHECK( fs::exists(directory / "a.tikz.pdf") );
+        CHECK( !results[1].cached );
+        CHECK( results[2].cached );
+
+        options.command = "false";
+        results = latex_build({write("d.tex", "d")}, options);
+        CHECK( results[0].status != 0 );
+
+        std::ostringstream report;
+        write_latex_build_report(report, results);
+        CHECK( report.str().find("  failed  " + (directory / "d.tex").string())
+               != std::string::npos );
+
+        fs::remove_all(directory);
+    }
+
+}
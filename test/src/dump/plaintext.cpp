@@ -1,11 +1,166 @@
 #include "dump/plaintext.hpp"
+#include "dump/boost_support.hpp"
+#include "dump/container_support.hpp"
+#include "dump/intrusive_support.hpp"
+#include "dump/multi_index_support.hpp"
+#include "dump/x3_support.hpp"
 #include "dump/demo/dumper.hpp"
 #include "test.hpp"
 
+#include <boost/circular_buffer.hpp>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
+#include <boost/container/static_vector.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/identity.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+
+#include <atomic>
+#include <deque>
+#include <forward_list>
 #include <fstream>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <variant>
 
 namespace dump {
 
+    namespace {
+
+        struct link {
+            int value;
+            link* next;
+        };
+
+        /*
+         * Container with a size but none of the supported types
+         */
+        struct ring {
+            int items[4];
+            std::size_t first;
+            std::size_t count;
+
+            struct iterator {
+                ring const* owner;
+                std::size_t offset;
+
+                typedef std::forward_iterator_tag iterator_category;
+                typedef int value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef int const* pointer;
+                typedef int const& reference;
+
+                int const& operator*() const {
+                    return owner->items[(owner->first + offset) % 4];
+                }
+
+                iterator& operator++() {
+                    ++offset;
+                    return *this;
+                }
+
+                bool operator==(iterator const& other) const {
+                    return offset == other.offset;
+                }
+
+                bool operator!=(iterator const& other) const {
+                    return offset != other.offset;
+                }
+            };
+
+            iterator begin() const {
+                return {this, 0};
+            }
+
+            iterator end() const {
+                return {this, count};
+            }
+
+            std::size_t size() const {
+                return count;
+            }
+        };
+
+        /*
+         * Leaves out engines, fuel types and arrays without operators for them
+         */
+        struct light_dumper : traversal<light_dumper> {
+            using traversal<light_dumper>::traversal;
+            using traversal<light_dumper>::operator();
+
+            typedef type_list<demo::engine, demo::fuel_type> excluded_types;
+
+            void operator()(demo::car const& obj) {
+                cNode(obj, "Car");
+                cAttr(obj, "model", obj.model, false, true);
+                cAttr(obj, "main engine", obj.main_engine, false);
+                cAttr(obj, "fuel", obj.main_engine.fuel, false, true);
+                cAttr(obj, "tires", obj.tires, true);
+            }
+        };
+
+        /*
+         * Pointers which can not be followed
+         */
+        struct handles {
+            void* opaque;
+            std::unique_ptr<int[]> buffer;
+            std::shared_ptr<int[]> shared;
+            void (*callback)();
+        };
+
+        struct handles_dumper : traversal<handles_dumper> {
+            using traversal<handles_dumper>::traversal;
+            using traversal<handles_dumper>::operator();
+
+            void operator()(handles const& obj) {
+                cNode(obj, "Handles");
+                cAttr(obj, "opaque", obj.opaque, false, true);
+                cAttr(obj, "buffer", obj.buffer, false, true);
+                cAttr(obj, "shared", obj.shared, false, true);
+                cAttr(obj, "callback", obj.callback, true, true);
+            }
+        };
+
+        struct hooked : boost::intrusive::list_base_hook<> {
+            int value;
+
+            explicit hooked(int value) : value(value) {}
+        };
+
+        struct hooked_dumper : traversal<hooked_dumper> {
+            using traversal<hooked_dumper>::traversal;
+            using traversal<hooked_dumper>::operator();
+
+            void operator()(hooked const& obj) {
+                cAttr(obj, "value", obj.value, true, true);
+            }
+        };
+
+        struct link_dumper : traversal<link_dumper> {
+            using traversal<link_dumper>::traversal;
+            using traversal<link_dumper>::operator();
+
+            void operator()(link const& obj) {
+                cNode(obj, "Link");
+                cAttr(obj, "value", obj.value, false, true);
+                cAttr(obj, "next", obj.next, true);
+            }
+        };
+
+    }
+
+    template <typename T, std::size_t N>
+    struct is_excluded<light_dumper, std::array<T, N>> : std::true_type {};
+
     TEST_CASE( "Dummy test case for plaintext", "[dumper]" ) {
         demo::tire t{"Tire Brand", 215, 16};
         demo::car c{"Car Brand", "Model 2000", 2002,
@@ -22,4 +177,352 @@ namespace dump {
         CHECK( true );
     }
 
+    TEST_CASE( "Opt-in support headers for plaintext", "[dumper]" ) {
+        namespace mi = boost::multi_index;
+        namespace x3 = boost::spirit::x3;
+
+        auto dump = [](auto const& obj) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper>{oss}(obj);
+            return oss.str();
+        };
+
+        CHECK( dump(boost::optional<int>{3}) == "'3'" );
+        CHECK( dump(boost::optional<int>{}) == "undefined" );
+        CHECK( dump(boost::variant<int, std::string>{std::string("x")})
+               == "x" );
+
+        boost::container::small_vector<int, 2> small{1, 2, 3};
+        CHECK( dump(small) == " size '3'\n"
+                              "|- item '1'\n"
+                              "|- item '2'\n"
+                              "`- item '3'" );
+
+        boost::container::static_vector<int, 4> fixed{7};
+        CHECK( dump(fixed) == " size '1'\n"
+                              "`- item '7'" );
+
+        boost::container::flat_map<std::string, int> flat{{"b", 2}, {"a", 1}};
+        CHECK( dump(flat) == " size '2'\n"
+                             "|- item \n"
+                             "| |- first a\n"
+                             "| `- second '1'\n"
+                             "`- item \n"
+                             "  |- first b\n"
+                             "  `- second '2'" );
+
+        boost::circular_buffer<int> events(3);
+        for(int i = 1; i <= 5; ++i) {
+            events.push_back(i);
+        }
+        CHECK( dump(events) == " size '3'\n"
+                               "|- item '3'\n"
+                               "|- item '4'\n"
+                               "`- item '5'" );
+        CHECK( dump(latest(events, 2)) == " size '3' skipped '1'\n"
+                                          "|- item '4'\n"
+                                          "`- item '5'" );
+        CHECK( dump(latest(events, 0)) == " size '3' skipped '3'" );
+        CHECK( dump(latest(events, 9)) == " size '3' skipped '0'\n"
+                                          "|- item '3'\n"
+                                          "|- item '4'\n"
+                                          "`- item '5'" );
+
+        hooked first{1};
+        hooked second{2};
+        boost::intrusive::list<hooked> hooks;
+        hooks.push_back(first);
+        hooks.push_back(second);
+        std::ostringstream intrusive;
+        {
+            plaintext_format format{intrusive};
+            hooked_dumper{format}(hooks);
+        }
+        CHECK( intrusive.str() == " size '2'\n"
+                                  "|- item  value '1'\n"
+                                  "`- item  value '2'" );
+        hooks.clear();
+
+        boost::multi_index_container<int, mi::indexed_by<
+            mi::ordered_unique<mi::identity<int>>>> ordered;
+        ordered.insert(5);
+        ordered.insert(1);
+        CHECK( dump(ordered) == " size '2'\n"
+                                "|- item '1'\n"
+                                "`- item '5'" );
+
+        struct by_width {};
+        boost::multi_index_container<demo::tire, mi::indexed_by<
+            mi::sequenced<>,
+            mi::ordered_non_unique<mi::tag<by_width>, mi::member<
+                demo::tire, unsigned, &demo::tire::width>>,
+            mi::hashed_unique<mi::member<
+                demo::tire, std::string, &demo::tire::manufacturer>>>> tires;
+        for(unsigned width : {215, 195, 205, 225}) {
+            tires.push_back({std::to_string(width), width, 16});
+        }
+        std::ostringstream indexed;
+        demo::dumper<plaintext_dumper>{indexed}(by_index<by_width>(tires));
+        CHECK( indexed.str().find(" index '1' kind ordered size '4'\n"
+                                  "|- item Tire manufacturer '195'") == 0 );
+        std::ostringstream ranged;
+        demo::dumper<plaintext_dumper>{ranged}(key_range<1>(tires, 205u, 225u));
+        CHECK( ranged.str() ==
+               " index '1' kind ordered size '4' count '2'\n"
+               "|- item Tire manufacturer '205' width '205' size '16.000000'\n"
+               "`- item Tire manufacturer '215' width '215' size '16.000000'" );
+        CHECK( dump(key_range<by_width>(tires, 230u, 240u))
+               == " index '1' kind ordered size '4' count '0'" );
+        CHECK( dump(key_range<by_width>(tires, 225u, 195u))
+               == " index '1' kind ordered size '4' count '0'" );
+        CHECK( dump(key_range<0>(ordered, 7, 3))
+               == " index '0' kind ordered size '2' count '0'" );
+        CHECK( dump(by_index<0>(tires)).find(" index '0' kind sequenced")
+               == 0 );
+        CHECK( dump(by_index<2>(tires)).find(" index '2' kind hashed") == 0 );
+
+        x3::variant<int, x3::forward_ast<std::string>> ast;
+        ast = x3::forward_ast<std::string>(std::string("ast"));
+        CHECK( dump(ast) == "ast" );
+    }
+
+    TEST_CASE( "Standard vocabulary types for plaintext", "[dumper]" ) {
+        auto dump = [](auto const& obj) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper>{oss}(obj);
+            return oss.str();
+        };
+
+        CHECK( dump(std::optional<int>{3}) == "'3'" );
+        CHECK( dump(std::optional<int>{}) == "undefined" );
+        CHECK( dump(std::variant<int, std::string>{std::string("x")})
+               == "x" );
+        CHECK( dump(std::atomic<int>{7}) == "'7'" );
+        CHECK( dump(std::make_pair(1, 2.5)) ==
+               "\n|- first '1'"
+               "\n`- second '2.500000'" );
+        CHECK( dump(std::make_tuple(1, 'a')) ==
+               "\n|- item '1'"
+               "\n`- item '97'" );
+        CHECK( dump(std::deque<int>{1, 2}) ==
+               " size '2'\n|- item '1'\n`- item '2'" );
+        CHECK( dump(std::list<int>{1}) == " size '1'\n`- item '1'" );
+
+        int const value = 5;
+        CHECK( dump(&value) == "'5'" );
+        CHECK( dump(static_cast<int const*>(nullptr)) == "undefined" );
+        CHECK( dump(std::make_unique<int>(6)) == "'6'" );
+        auto shared = std::make_shared<int>(8);
+        CHECK( dump(std::weak_ptr<int>(shared)) == "'8'" );
+        shared.reset();
+        CHECK( dump(std::weak_ptr<int>(shared)) == "undefined" );
+        CHECK( dump(static_cast<char const*>("text")) == "text" );
+
+        handles h{&shared, std::make_unique<int[]>(2),
+                  std::shared_ptr<int[]>(new int[2]), nullptr};
+        std::ostringstream oss;
+        {
+            plaintext_format format{oss};
+            handles_dumper{format}(h);
+        }
+        std::string const& out = oss.str();
+        std::size_t unsupported = 0;
+        for(std::size_t at = out.find("not implemented");
+            at != std::string::npos;
+            at = out.find("not implemented", at + 1)) {
+            ++unsupported;
+        }
+        CHECK( unsupported == 4 );
+    }
+
+    TEST_CASE( "Pointer cycles for plaintext", "[dumper]" ) {
+        link a{1, nullptr};
+        link b{2, &a};
+        a.next = &b;
+
+        std::ostringstream oss;
+        {
+            plaintext_format format{oss};
+            link_dumper{format}(&a);
+        }
+        std::string const& out = oss.str();
+        std::string const& expected =
+            "Link value '1'\n"
+            "`- next Link value '2'\n"
+            "  `- next cycle ";
+        CHECK( out.substr(0, expected.size()) == expected );
+        CHECK( out.find("link", expected.size()) != std::string::npos );
+    }
+
+    TEST_CASE( "Generic ranges for plaintext", "[dumper]" ) {
+        auto dump = [](auto const& obj) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper>{oss}(obj);
+            return oss.str();
+        };
+
+        ring r{{1, 2, 3, 4}, 3, 2};
+        CHECK( dump(r) == " size '2'\n|- item '4'\n`- item '1'" );
+
+        std::forward_list<int> forward{1, 2};
+        CHECK( dump(forward) == "\n|- item '1'\n`- item '2'" );
+        CHECK( dump(std::forward_list<int>{}) == "" );
+
+        int array[] = {3, 4};
+        CHECK( dump(array) == "\n|- item '3'\n`- item '4'" );
+
+        std::istringstream input{"5 6"};
+        struct {
+            std::istream& in;
+            std::istream_iterator<int> begin() const {
+                return std::istream_iterator<int>(in);
+            }
+            std::istream_iterator<int> end() const {
+                return std::istream_iterator<int>();
+            }
+        } numbers{input};
+        CHECK( dump(numbers) == "\n|- item '5'\n`- item '6'" );
+
+        CHECK( dump(string_view("view")) == "view" );
+    }
+
+    TEST_CASE( "Collapsed runs of list items for plaintext", "[dumper]" ) {
+        auto dump = [](auto const& obj) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper> dumper{oss};
+            dumper.policy.options.collapse_runs = true;
+            dumper(obj);
+            return oss.str();
+        };
+
+        std::vector<int> numbers{1, 1, 2, 2, 2, 3};
+        CHECK( dump(numbers) ==
+               " size '6'\n"
+               "|- item \xc3\x97" "2 '1'\n"
+               "|- item \xc3\x97" "3 '2'\n"
+               "`- item '3'" );
+
+        std::vector<std::vector<int>> zeros(3, std::vector<int>(4, 0));
+        CHECK( dump(zeros) ==
+               " size '3'\n"
+               "`- item \xc3\x97" "3  size '4'\n"
+               "  `- item \xc3\x97" "4 '0'" );
+
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        CHECK( dump(c).find("`- tires Tires size '4'\n"
+                            "  `- item \xc3\x97" "4 Tire") !=
+               std::string::npos );
+        CHECK( dump(std::vector<int>()) == " size '0'" );
+
+        // numbers which are written alike are identical
+        std::vector<double> reals{1.0000001, 1.0000002};
+        CHECK( dump(reals) ==
+               " size '2'\n"
+               "`- item \xc3\x97" "2 '1.000000'" );
+
+        // selections address the single items
+        path_query const query{"tires/item[2]/width"};
+        CHECK( dump(select(c, query)) ==
+               "Car\n"
+               "`- tires Tires\n"
+               "  `- item Tire width '215'" );
+    }
+
+    TEST_CASE( "Path selection for plaintext", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        auto dump = [&c](char const* pattern) {
+            std::ostringstream oss;
+            path_query const query{pattern};
+            demo::dumper<plaintext_dumper>{oss}(select(c, query));
+            return oss.str();
+        };
+
+        CHECK( dump("tires/item[2]/width") ==
+               "Car\n"
+               "`- tires Tires\n"
+               "  `- item Tire width '215'" );
+        CHECK( dump("**/main engine") ==
+               "Car\n"
+               "`- main engine Engine fuel electric power '69.000000'" );
+        CHECK( dump("*/fuel") ==
+               "Car\n"
+               "`- main engine Engine fuel electric" );
+        CHECK( dump("tires/*[1]/manufacturer") ==
+               "Car\n"
+               "`- tires Tires\n"
+               "  `- item Tire manufacturer 'Tire Brand'" );
+        CHECK( dump("nothing") == "Car" );
+
+        std::ostringstream full;
+        demo::dumper<plaintext_dumper>{full}(c);
+        CHECK( dump("**") == full.str() );
+
+        CHECK_THROWS_AS( path_query{"item[x]"}, std::invalid_argument );
+        CHECK_THROWS_AS( path_query{"**[1]"}, std::invalid_argument );
+    }
+
+    TEST_CASE( "Excluded types for plaintext", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        std::ostringstream oss;
+        plaintext_format format{oss};
+        light_dumper{format}(c);
+        CHECK( oss.str() ==
+               "Car model 'Model 2000'\n"
+               "|- main engine excluded fuel excluded\n"
+               "`- tires excluded" );
+
+        // behind wrappers too
+        auto const dump = [](auto const& wrapper) {
+            std::ostringstream oss;
+            plaintext_format format{oss};
+            light_dumper{format}(wrapper);
+            return oss.str();
+        };
+        demo::engine const e{demo::fuel_type::electric, 69};
+        CHECK( dump(std::optional<demo::engine>(e)) == "excluded" );
+        CHECK( dump(boost::optional<demo::engine>(e)) == "excluded" );
+        CHECK( dump(boost::variant<int, demo::engine>(e)) == "excluded" );
+        CHECK( dump(std::atomic<demo::fuel_type>(demo::fuel_type::gas))
+               == "excluded" );
+        CHECK( dump(std::optional<int>(3)) == "'3'" );
+    }
+
+    TEST_CASE( "Value limits for plaintext", "[dumper]" ) {
+        auto dump = [](std::string const& text, std::size_t chars,
+                       std::size_t lines) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper> dumper{oss};
+            dumper.policy.options.max_value_chars = chars;
+            dumper.policy.options.max_value_lines = lines;
+            dumper(std::make_pair(text, 1));
+            return oss.str();
+        };
+
+        std::string const digits = "0123456789";
+        CHECK( dump(digits, 10, 0) == "\n|- first 0123456789\n`- second '1'" );
+        CHECK( dump(digits, 6, 0) ==
+               "\n|- first 012\xe2\x80\xa6(4 bytes elided)789"
+               "\n`- second '1'" );
+        CHECK( dump("a\nb\nc\nd\ne", 0, 4) ==
+               "\n|- first a\n"
+               "|        b\n"
+               "|        \xe2\x80\xa6(2 bytes elided)\n"
+               "|        d\n"
+               "|        e"
+               "\n`- second '1'" );
+        CHECK( dump("a\nb\nc\nd\ne", 0, 5) ==
+               dump("a\nb\nc\nd\ne", 0, 0) );
+
+        // sequences are not split
+        std::string buffer;
+        CHECK( truncate(buffer, "a\xc3\x97\xc3\x97" "b", 4, 0) ==
+               "a\xe2\x80\xa6(4 bytes elided)b" );
+    }
+
 }
@@ -0,0 +1,180 @@
+#include "dump/console.hpp"
+#include "dump/plaintext.hpp"
+#include "dump/render_cache.hpp"
+#include "dump/std_support.hpp"
+#include "test.hpp"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    namespace {
+
+        struct config {
+            std::string name;
+            std::string notes;
+            std::vector<int> values;
+        };
+
+        struct program {
+            std::vector<std::shared_ptr<config const>> blocks;
+            std::uint64_t generation;
+        };
+
+        std::size_t config_dumps = 0;
+
+        template <template <typename> class Base>
+        struct program_dumper : Base<program_dumper<Base>> {
+            using Base<program_dumper<Base>>::Base;
+            using Base<program_dumper<Base>>::operator();
+
+            void operator()(config const& obj) {
+                ++config_dumps;
+                this->cNode(obj, "Config");
+                this->cAttr(obj, "name", obj.name, false, true);
+                this->cAttr(obj, "notes", obj.notes, false);
+                this->cAttr(obj, "values", obj.values, true);
+            }
+
+            void operator()(program const& obj) {
+                this->cNode(obj, "Program");
+                std::size_t left = obj.blocks.size();
+                for(auto const& block : obj.blocks) {
+                    this->cListAttr(obj, "block",
+                                    cached(*block, obj.generation),
+                                    --left == 0);
+                }
+            }
+        };
+
+        struct brief_dumper : plaintext_dumper<brief_dumper> {
+            using plaintext_dumper<brief_dumper>::plaintext_dumper;
+            using plaintext_dumper<brief_dumper>::operator();
+
+            void operator()(config const& obj) {
+                this->cNode(obj, "Config");
+                this->cAttr(obj, "name", obj.name, true, true);
+            }
+
+            void operator()(program const& obj) {
+                this->cNode(obj, "Program");
+                std::size_t left = obj.blocks.size();
+                for(auto const& block : obj.blocks) {
+                    this->cListAttr(obj, "block",
+                                    cached(*block, obj.generation),
+                                    --left == 0);
+                }
+            }
+        };
+
+        template <template <typename> class Base>
+        std::string dump(program const& obj, render_cache* cache,
+                         dump_options options = dump_options()) {
+            std::ostringstream oss;
+            program_dumper<Base> dumper{oss};
+            dumper.policy.options = options;
+            dumper.policy.options.cache = cache;
+            dumper(obj);
+            return oss.str();
+        }
+
+    }
+
+    TEST_CASE( "Render cache for plaintext and console", "[dumper]" ) {
+        auto shared = std::make_shared<config const>(
+            config{"shared", "first line\nsecond line", {1, 2}});
+        auto other = std::make_shared<config const>(
+            config{"other", "", {}});
+        program p{{shared, other, shared, shared}, 1};
+
+        std::string const& expected = dump<plaintext_dumper>(p, nullptr);
+        // re-indented for the last block
+        CHECK( expected.find("`- block Config name 'shared'\n"
+                             "  |- notes first line\n"
+                             "  |        second line\n"
+                             "  `- values  size '2'\n"
+                             "    |- item '1'\n"
+                             "    `- item '2'") != std::string::npos );
+
+        render_cache cache{1 << 16};
+        config_dumps = 0;
+        CHECK( dump<plaintext_dumper>(p, &cache) == expected );
+        CHECK( config_dumps == 2 );
+        CHECK( cache.hits == 2 );
+
+        // hits only, without traversing the configs again
+        config_dumps = 0;
+        CHECK( dump<plaintext_dumper>(p, &cache) == expected );
+        CHECK( config_dumps == 0 );
+
+        // policies and versions are cached separately
+        CHECK( dump<console_dumper>(p, &cache) ==
+               dump<console_dumper>(p, nullptr) );
+        p.generation = 2;
+        config_dumps = 0;
+        CHECK( dump<plaintext_dumper>(p, &cache) == expected );
+        CHECK( config_dumps == 2 );
+    }
+
+    TEST_CASE( "Render cache by dumper and options", "[dumper]" ) {
+        auto shared = std::make_shared<config const>(
+            config{"shared", "first line\nsecond line", {7, 7}});
+        program p{{shared, shared}, 1};
+
+        render_cache cache{1 << 16};
+        std::string const& full = dump<plaintext_dumper>(p, &cache);
+
+        std::ostringstream brief;
+        brief_dumper{brief}(p);
+        std::ostringstream cached_brief;
+        {
+            brief_dumper dumper{cached_brief};
+            dumper.policy.options.cache = &cache;
+            dumper(p);
+        }
+        CHECK( cached_brief.str() == brief.str() );
+        CHECK( cached_brief.str().find("notes") == std::string::npos );
+
+        dump_options elided;
+        elided.max_value_chars = 4;
+        std::string const& expected = dump<plaintext_dumper>(p, nullptr,
+                                                             elided);
+        CHECK( expected != full );
+        CHECK( dump<plaintext_dumper>(p, &cache, elided) == expected );
+        dump_options collapsed;
+        collapsed.collapse_runs = true;
+        std::string const& runs = dump<plaintext_dumper>(p, nullptr,
+                                                         collapsed);
+        CHECK( runs.find("item ×2") != std::string::npos );
+        CHECK( dump<plaintext_dumper>(p, &cache, collapsed) == runs );
+
+        // and the full dump is still cached
+        config_dumps = 0;
+        CHECK( dump<plaintext_dumper>(p, &cache) == full );
+        CHECK( config_dumps == 0 );
+    }
+
+    TEST_CASE( "Render cache eviction", "[cache]" ) {
+        config c{"c", "", {}};
+        render_cache cache{10};
+        auto const key = [&c](std::uint64_t version) {
+            return render_cache::key{object_ref(c), &typeid(plaintext_format),
+                                     &typeid(void), version, ""};
+        };
+        cache.insert(key(1), "1234");
+        cache.insert(key(2), "1234");
+        CHECK( cache.find(key(1)) != nullptr );
+        cache.insert(key(3), "1234");
+        CHECK( cache.size() == 2 );
+        CHECK( cache.bytes() == 8 );
+        CHECK( cache.find(key(2)) == nullptr );
+        CHECK( *cache.find(key(1)) == "1234" );
+        cache.insert(key(4), "too long to cache");
+        CHECK( cache.find(key(4)) == nullptr );
+        CHECK( cache.size() == 2 );
+    }
+
+}
@@ -0,0 +1,47 @@
+#include "dump/forest.hpp"
+#include "dump/plaintext.hpp"
+#include "dump/session.hpp"
+#include "dump/tikz.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace dump {
+
+    namespace {
+
+        template <template <typename> class Base, typename Format,
+                  typename T>
+        void check_session(T const& obj) {
+            std::ostringstream expected;
+            demo::dumper<Base>{expected}(obj);
+
+            session<Format> s;
+            for(int i = 0; i < 3; ++i) {
+                std::ostringstream out;
+                s.template dump<demo::dumper<Base>>(out, obj);
+                CHECK( out.str() == expected.str() );
+            }
+        }
+
+    }
+
+    TEST_CASE( "Sessions for every format", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        check_session<plaintext_dumper, plaintext_format>(c);
+        check_session<forest_dumper, forest_format>(c);
+        check_session<tikz_dumper, tikz_format>(c);
+
+        // the policy options are kept
+        session<plaintext_format> s;
+        s.format.options.max_value_chars = 4;
+        std::ostringstream out;
+        s.dump<demo::dumper<plaintext_dumper>>(out, c.model);
+        CHECK( out.str() == "Mo\xe2\x80\xa6(6 bytes elided)00" );
+    }
+
+}
@@ -0,0 +1,99 @@
+#include "dump/plaintext.hpp"
+#include "dump/summary.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace dump {
+
+    TEST_CASE( "Summary of numeric arrays for plaintext", "[dumper]" ) {
+        auto dump = [](auto const& obj) {
+            std::ostringstream oss;
+            demo::dumper<plaintext_dumper>{oss}(obj);
+            return oss.str();
+        };
+
+        float const nan = std::numeric_limits<float>::quiet_NaN();
+        float const inf = std::numeric_limits<float>::infinity();
+        std::vector<float> samples{4, nan, 1, -inf, 2, 3, 0, 6};
+
+        summary_options options;
+        options.bins = 2;
+        options.head = 2;
+        options.tail = 1;
+        CHECK( dump(summarize(samples, options)) ==
+               "Summary size '8' min '0.000000' max '6.000000'"
+               " mean '2.666667' nan '1' inf '1'\n"
+               "|- histogram  size '2'\n"
+               "| |- item '3'\n"
+               "| `- item '3'\n"
+               "|- head  size '2'\n"
+               "| |- item '4.000000'\n"
+               "| `- item 'nan'\n"
+               "`- tail  size '1'\n"
+               "  `- item '6.000000'" );
+
+        std::array<int, 3> ints{{7, -2, 4}};
+        CHECK( dump(summarize(ints)) ==
+               "Summary size '3' min '-2' max '7' mean '3.000000'" );
+
+        std::vector<double> none;
+        CHECK( dump(summarize(none)) ==
+               "Summary size '0' nan '0' inf '0'" );
+    }
+
+    TEST_CASE( "Summary statistics match a scalar reduction", "[summary]" ) {
+        std::vector<float> floats;
+        std::vector<double> doubles;
+        for(int i = 0; i < 1003; ++i) {
+            float const value = std::sin(i * 0.37f) * (i % 17);
+            floats.push_back(i % 97 == 5
+                             ? std::numeric_limits<float>::quiet_NaN()
+                             : i % 89 == 3
+                             ? -std::numeric_limits<float>::infinity()
+                             : value);
+            doubles.push_back(floats.back());
+        }
+
+        float low = std::numeric_limits<float>::infinity();
+        float high = -low;
+        double sum = 0;
+        std::size_t finite = 0;
+        for(float value : floats) {
+            if(std::isfinite(value)) {
+                low = std::min(low, value);
+                high = std::max(high, value);
+                sum += value;
+                ++finite;
+            }
+        }
+
+        summary_stats<float> const& f = statistics(floats.data(),
+                                                   floats.size(), 0);
+        CHECK( f.finite == finite );
+        CHECK( f.nans == 11 );
+        CHECK( f.infs == floats.size() - finite - 11 );
+        CHECK( f.min == low );
+        CHECK( f.max == high );
+        CHECK( f.mean == Approx(sum / finite) );
+
+        summary_stats<double> const& d = statistics(doubles.data(),
+                                                    doubles.size(), 4);
+        CHECK( d.finite == finite );
+        CHECK( d.nans == 11 );
+        CHECK( d.min == low );
+        CHECK( d.max == high );
+        CHECK( d.mean == Approx(sum / finite) );
+        std::size_t binned = 0;
+        for(std::size_t count : d.histogram) {
+            binned += count;
+        }
+        CHECK( binned == finite );
+    }
+
+}
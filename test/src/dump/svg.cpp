@@ -0,0 +1,121 @@
+#include "dump/svg.hpp"
+#include "dump/tikz.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dump {
+
+    namespace {
+
+        std::size_t count(std::string const& text, std::string const& part) {
+            std::size_t found = 0;
+            for(std::size_t at = text.find(part); at != std::string::npos;
+                at = text.find(part, at + part.size())) {
+                ++found;
+            }
+            return found;
+        }
+
+        struct link {
+            int value;
+            link* next;
+        };
+
+        struct link_dumper : traversal<link_dumper> {
+            using traversal<link_dumper>::traversal;
+            using traversal<link_dumper>::operator();
+
+            void operator()(link const& obj) {
+                cNode(obj, "Link");
+                cAttr(obj, "value", obj.value, false, true);
+                cAttr(obj, "next", obj.next, true);
+            }
+        };
+
+    }
+
+    TEST_CASE( "Layered layout", "[dumper]" ) {
+        // a cycle 0 -> 1 -> 2 -> 0, a long edge 0 -> 2, a loop and an
+        // unconnected node
+        std::vector<layout_node> nodes(4, layout_node{30, 10, 0, 0});
+        nodes[3].width = 50;
+        std::vector<layout_edge> edges{{0, 1, {}}, {1, 2, {}}, {2, 0, {}},
+                                       {0, 2, {}}, {1, 1, {}}};
+        layered_layout(nodes, edges);
+
+        CHECK( nodes[0].y < nodes[1].y );
+        CHECK( nodes[1].y < nodes[2].y );
+        CHECK( nodes[3].y == nodes[0].y );
+        CHECK( (nodes[3].x >= nodes[0].x + 30 + 20
+                || nodes[0].x >= nodes[3].x + 50 + 20) );
+
+        auto const bottom = [&nodes](std::size_t i) {
+            return layout_point{nodes[i].x + nodes[i].width / 2,
+                                nodes[i].y + nodes[i].height};
+        };
+        auto const top = [&nodes](std::size_t i) {
+            return layout_point{nodes[i].x + nodes[i].width / 2, nodes[i].y};
+        };
+        auto const same = [](layout_point a, layout_point b) {
+            return a.x == b.x && a.y == b.y;
+        };
+        CHECK( edges[0].points.size() == 2 );
+        CHECK( same(edges[0].points.front(), bottom(0)) );
+        CHECK( same(edges[0].points.back(), top(1)) );
+        // the reversed edge still leads from its source to its target
+        CHECK( edges[2].points.size() == 4 );
+        CHECK( same(edges[2].points.front(), top(2)) );
+        CHECK( same(edges[2].points.back(), bottom(0)) );
+        // with a bend on the layer of 1, beside it
+        CHECK( edges[3].points.size() == 4 );
+        CHECK( edges[3].points[1].y == nodes[1].y );
+        CHECK( (edges[3].points[1].x >= nodes[1].x + 30
+                || edges[3].points[1].x <= nodes[1].x) );
+        CHECK( edges[4].points.size() == 4 );
+        CHECK( edges[4].points.front().x == nodes[1].x + 30 );
+    }
+
+    TEST_CASE( "SVG graph with the nodes of tikz", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+
+        std::ofstream file{"svg.svg"};
+        demo::dumper<svg_dumper>{file}(c);
+
+        std::ostringstream svg;
+        demo::dumper<svg_dumper>{svg}(c);
+        std::ostringstream tikz;
+        demo::dumper<tikz_dumper>{tikz}(c);
+        CHECK( count(svg.str(), "<rect ") == count(tikz.str(), "\\node\n") );
+        CHECK( count(svg.str(), "<polyline ") == count(tikz.str(), "\\draw") );
+        CHECK( svg.str().find("<tspan font-style=\"italic\">manufacturer"
+                              "</tspan> Car Brand</tspan>")
+               != std::string::npos );
+
+        // the cycle is drawn as an edge back to the first link
+        link a{1, nullptr};
+        link b{2, &a};
+        a.next = &b;
+        std::ostringstream cycle;
+        {
+            svg_format format{cycle};
+            link_dumper{format}(&a);
+        }
+        CHECK( count(cycle.str(), "<rect ") == 2 );
+        CHECK( count(cycle.str(), "<polyline ") == 2 );
+
+        std::vector<demo::car> cars(1500, c);
+        std::ostringstream large;
+        demo::dumper<svg_dumper>{large}(cars);
+        CHECK( count(large.str(), "<rect ") == 1 + 1500 * 7 );
+        CHECK( large.str().substr(large.str().size() - 7) == "</svg>\n" );
+    }
+
+}
@@ -3,7 +3,11 @@
 #include "dump/demo/dumper.hpp"
 #include "test.hpp"
 
+#include <algorithm>
 #include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace dump {
 
@@ -27,4 +31,99 @@ namespace dump {
         CHECK( true );
     }
 
+    TEST_CASE( "Streaming tikz with spilled edges", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        auto lines = [](std::string const& text) {
+            std::istringstream in(text);
+            std::vector<std::string> result;
+            for(std::string line; std::getline(in, line);) {
+                result.push_back(line);
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        };
+
+        std::ostringstream buffered;
+        demo::dumper<tikz_dumper>{buffered}(c);
+        for(std::size_t edge_buffer : {std::size_t(1), std::size_t(1 << 20)}) {
+            tikz_streaming streaming;
+            streaming.edge_buffer = edge_buffer;
+            std::ostringstream streamed;
+            demo::dumper<tikz_dumper>{streamed, streaming}(c);
+            // the same nodes and edges, only the edges in another order
+            CHECK( lines(streamed.str()) == lines(buffered.str()) );
+            std::size_t const first_edge = streamed.str().find("\\draw (");
+            CHECK( first_edge != std::string::npos );
+            CHECK( first_edge > streamed.str().rfind("};") );
+            CHECK( streamed.str().size() == buffered.str().size() );
+        }
+    }
+
+    TEST_CASE( "Tidy tree layout", "[dumper]" ) {
+        // 0 with the children 1, 2 and 3, and 4 and 5 below 1 and 3
+        std::vector<layout_node> nodes{{40, 10, 0, 0}, {20, 10, 0, 0},
+                                       {60, 20, 0, 0}, {20, 10, 0, 0},
+                                       {100, 10, 0, 0}, {100, 10, 0, 0}};
+        std::vector<std::size_t> const parents{no_parent, 0, 0, 0, 1, 3};
+        tree_layout(nodes, parents);
+        auto const center = [&nodes](std::size_t i) {
+            return nodes[i].x + nodes[i].width / 2;
+        };
+
+        CHECK( nodes[0].y == 0 );
+        CHECK( nodes[1].y == 50 );
+        CHECK( nodes[2].y == 50 );
+        // below the tallest node of the layer above
+        CHECK( nodes[4].y == 110 );
+        CHECK( center(1) == center(4) );
+        CHECK( center(3) == center(5) );
+        CHECK( nodes[5].x == nodes[4].x + 100 + 20 );
+        // the subtree in between is spread evenly
+        CHECK( center(2) - center(1) == center(3) - center(2) );
+        CHECK( center(0) == (center(1) + center(3)) / 2 );
+        CHECK( nodes[4].x == 0 );
+    }
+
+    TEST_CASE( "Tikz with a precomputed tree layout", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::car c{"Car Brand", "Model 2000", 2002,
+                    {demo::fuel_type::electric, 69}, {t, t, t, t}};
+        auto count = [](std::string const& text, std::string const& part) {
+            std::size_t found = 0;
+            for(std::size_t at = text.find(part); at != std::string::npos;
+                at = text.find(part, at + part.size())) {
+                ++found;
+            }
+            return found;
+        };
+
+        // without graphdrawing, which needs LuaLaTeX
+        std::string const& header = ::dump::latex_support{}.get_header(false);
+        CHECK( header.find("graphdrawing") == std::string::npos );
+        CHECK( header.find("\\usetikzlibrary{shapes}") != std::string::npos );
+        CHECK( ::dump::latex_support{}.get_header().find("\\usegdlibrary")
+               != std::string::npos );
+
+        std::ofstream file{"tikz_placed.tex"};
+        file << header;
+        demo::dumper<tikz_dumper>{file, layout_options()}(c);
+        file << ::dump::latex_support{}.get_footer();
+
+        std::ostringstream layered;
+        demo::dumper<tikz_dumper>{layered}(c);
+        std::ostringstream placed;
+        demo::dumper<tikz_dumper>{placed, layout_options()}(c);
+        std::string const& out = placed.str();
+        CHECK( out.find("layered layout") == std::string::npos );
+        CHECK( count(out, "\\node\n") == count(layered.str(), "\\node\n") );
+        CHECK( count(out, "\\draw") == count(layered.str(), "\\draw") );
+        CHECK( count(out, ", anchor=north]\n") == 7 );
+        // the nodes are all written before the edges
+        CHECK( out.rfind(")\n\t at (") < out.find("\\draw") );
+        // the four tires on one layer
+        CHECK( count(out, "pt,-246.06pt)\n") == 4 );
+    }
+
 }
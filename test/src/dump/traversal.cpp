@@ -0,0 +1,52 @@
+#include "dump/console.hpp"
+#include "dump/forest.hpp"
+#include "dump/plaintext.hpp"
+#include "dump/tikz.hpp"
+#include "dump/demo/dumper.hpp"
+#include "test.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace dump {
+
+    namespace {
+
+        template <template <typename> class Base, typename T>
+        std::string dump_with_base(T const& obj) {
+            std::ostringstream oss;
+            demo::dumper<Base>{oss}(obj);
+            return oss.str();
+        }
+
+        template <typename Format, typename T>
+        std::string dump_with_format(T const& obj) {
+            std::ostringstream oss;
+            {
+                Format format{oss};
+                demo::dumper<traversal>{format}(obj);
+            }
+            return oss.str();
+        }
+
+    }
+
+    TEST_CASE( "One traversal for all formats", "[dumper]" ) {
+        demo::tire t{"Tire Brand", 215, 16};
+        demo::cars cs{
+            {"Car Brand", "Model 2000", 2002,
+             {demo::fuel_type::electric, 69}, {t, t, t, t}},
+            {"Car Brand", "Model 3000", 2003,
+             {demo::fuel_type::diesel, 96}, {t, t, t, t}}};
+
+        CHECK( dump_with_format<plaintext_format>(cs)
+               == dump_with_base<plaintext_dumper>(cs) );
+        CHECK( dump_with_format<console_format>(cs)
+               == dump_with_base<console_dumper>(cs) );
+        CHECK( dump_with_format<forest_format>(cs)
+               == dump_with_base<forest_dumper>(cs) );
+        CHECK( dump_with_format<tikz_format>(cs)
+               == dump_with_base<tikz_dumper>(cs) );
+    }
+
+}
@@ -0,0 +1,80 @@
+/*
+ * Compile LaTeX dumps to PDF, see `dump::latex_build`.
+ *
+ * Usage: dump_latex_build [-j jobs] [--cache directory] [--command command]
+ *                         [source.tex...]
+ *
+ * Without sources, all `.tikz.tex` and `.forest.tex` files written by
+ * `dump::fs` into the temporary directory are compiled. Exits with 1 if a
+ * source failed to compile.
+ */
+
+#include "dump/latex_build.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    bool ends_with(std::string const& text, std::string const& suffix) {
+        return text.size() >= suffix.size()
+            && text.compare(text.size() - suffix.size(), suffix.size(),
+                            suffix) == 0;
+    }
+
+    std::vector<std::string> temporary_dumps() {
+        namespace fs = boost::filesystem;
+        std::vector<std::string> sources;
+        for(fs::directory_entry const& entry :
+                fs::directory_iterator(fs::temp_directory_path())) {
+            std::string const& path = entry.path().string();
+            if(ends_with(path, ".tikz.tex") || ends_with(path, ".forest.tex")) {
+                sources.push_back(path);
+            }
+        }
+        std::sort(sources.begin(), sources.end());
+        return sources;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    dump::latex_build_options options;
+    std::vector<std::string> sources;
+    for(int i = 1; i < argc; ++i) {
+        bool const has_value = i + 1 < argc;
+        if(std::strcmp(argv[i], "-j") == 0 && has_value) {
+            options.jobs = static_cast<unsigned int>(std::atoi(argv[++i]));
+        } else if(std::strcmp(argv[i], "--cache") == 0 && has_value) {
+            options.cache = argv[++i];
+        } else if(std::strcmp(argv[i], "--command") == 0 && has_value) {
+            options.command = argv[++i];
+        } else if(argv[i][0] == '-') {
+            std::cerr << "usage: " << argv[0] << " [-j jobs]"
+                      << " [--cache directory] [--command command]"
+                      << " [source.tex...]" << std::endl;
+            return 2;
+        } else {
+            sources.push_back(argv[i]);
+        }
+    }
+    if(sources.empty()) {
+        sources = temporary_dumps();
+    }
+
+    std::vector<dump::latex_build_result> const& results =
+        dump::latex_build(sources, options);
+    dump::write_latex_build_report(std::cout, results);
+    for(dump::latex_build_result const& result : results) {
+        if(result.status != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}